@@ -0,0 +1,52 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Test Runner
+// Runs VSC_TestSuite through the engine test harness when launched with -vscTest, writes a
+// JUnit report to $profile:VSC/test_report.xml and optionally exits (-vscTestQuit).
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+class VSC_TestRunner
+{
+	static const string CLI_TEST = "vscTest";
+	static const string CLI_TEST_QUIT = "vscTestQuit";
+	static const string REPORT_PATH = "$profile:VSC/test_report.xml";
+
+	//------------------------------------------------------------------------------------------------
+	static void RunFromCommandLine()
+	{
+		if (!System.IsCLIParam(CLI_TEST))
+			return;
+
+		Print("[VSC Test] Running VSC_TestSuite", LogLevel.NORMAL);
+		TestHarness.Begin();
+
+		// The harness may spread steps over frames - poll until it reports completion
+		GetGame().GetCallqueue(CALL_CATEGORY_SYSTEM).CallLater(Poll, 0, true);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static void Poll()
+	{
+		if (!TestHarness.Run())
+			return;
+
+		GetGame().GetCallqueue(CALL_CATEGORY_SYSTEM).Remove(Poll);
+
+		string report = TestHarness.Report();
+		TestHarness.End();
+
+		FileIO.MakeDirectory(VSC_Trace.DIRECTORY);
+		FileHandle file = FileIO.OpenFile(REPORT_PATH, FileMode.WRITE);
+		if (file)
+		{
+			file.Write(report);
+			file.Close();
+		}
+
+		Print("[VSC Test] Finished, report written to " + REPORT_PATH, LogLevel.NORMAL);
+		Print(report, LogLevel.NORMAL);
+
+		if (System.IsCLIParam(CLI_TEST_QUIT))
+			GetGame().RequestClose();
+	}
+}
@@ -0,0 +1,249 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Test Scenario
+// Synthetic, deterministic inputs for driving the pipeline in autotests without a world.
+// Listener sits at the origin facing +Z, sources are laid out on a golden-angle spiral.
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+class VSC_TestScenario
+{
+	static const float ORIGINAL_RANGE = 100.0;
+	static const float TICK_MS = 50.0;
+	static const float START_TIME = 1000.0;
+
+	ref VSC_FrameInput m_Input = new VSC_FrameInput();
+	ref VSC_InputFrame m_Frame = new VSC_InputFrame();
+	ref VSC_TestHearingOutput m_Output = new VSC_TestHearingOutput();
+	ref VSC_AudioOutput m_Audio = new VSC_AudioOutput();
+	ref VSC_StageStats m_Stats = new VSC_StageStats();
+	ref VSC_ProtectionProfile m_ProtectionProfile = new VSC_ProtectionProfile();
+	ref VSC_BOSSAProfile m_BOSSAProfile = new VSC_BOSSAProfile();
+	ref VSC_Pipeline m_Pipeline;
+	ref VSC_LearnedState m_LearnedState; // Optional warm-start state
+
+	//------------------------------------------------------------------------------------------------
+	void VSC_TestScenario()
+	{
+		m_Frame.m_fTime = START_TIME;
+		m_Frame.m_vListenerOrigin = vector.Zero;
+		m_Frame.m_vListenerForward = "0 0 1";
+		m_Input.SetFrame(m_Frame);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Build and activate the pipeline (profiles may be tweaked before this)
+	//------------------------------------------------------------------------------------------------
+	void Start(bool withProtection = true, bool withBOSSA = true)
+	{
+		VSC_ProtectionProfile protectionProfile;
+		if (withProtection)
+			protectionProfile = m_ProtectionProfile;
+
+		VSC_BOSSAProfile bossaProfile;
+		if (withBOSSA)
+			bossaProfile = m_BOSSAProfile;
+
+		m_Pipeline = new VSC_Pipeline(m_Input, protectionProfile, bossaProfile, m_Output);
+		m_Pipeline.SetStageStats(m_Stats);
+		m_Pipeline.SetAudioOutput(m_Audio);
+		m_Pipeline.SetLearnedState(m_LearnedState);
+		m_Pipeline.Activate(ORIGINAL_RANGE);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Add count sources between minDistance and maxDistance
+	//------------------------------------------------------------------------------------------------
+	void AddSources(int count, float minDistance = 5.0, float maxDistance = 120.0, int classFlags = EVSC_SourceClass.CHARACTER | EVSC_SourceClass.MOVEMENT)
+	{
+		int first = m_Frame.m_aSources.Count();
+		for (int i = 0; i < count; i++)
+		{
+			int index = first + i;
+			float angle = index * 137.508 * Math.DEG2RAD;
+			float distance = minDistance + (maxDistance - minDistance) * ((index * 37) % 100) / 100.0;
+
+			VSC_SourceSample sample = new VSC_SourceSample();
+			sample.m_sId = "test" + index;
+			sample.m_vPosition = Vector(Math.Sin(angle) * distance, 0, Math.Cos(angle) * distance);
+			sample.m_iClassFlags = classFlags;
+			m_Frame.m_aSources.Insert(sample);
+		}
+
+		m_Input.SetFrame(m_Frame);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Add a single source at a fixed position
+	//------------------------------------------------------------------------------------------------
+	void AddSourceAt(vector position, int classFlags = EVSC_SourceClass.CHARACTER | EVSC_SourceClass.MOVEMENT)
+	{
+		VSC_SourceSample sample = new VSC_SourceSample();
+		sample.m_sId = "test" + m_Frame.m_aSources.Count();
+		sample.m_vPosition = position;
+		sample.m_iClassFlags = classFlags;
+		m_Frame.m_aSources.Insert(sample);
+		m_Input.SetFrame(m_Frame);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Move a previously added source (takes effect from the next tick)
+	//------------------------------------------------------------------------------------------------
+	void MoveSource(int index, vector position)
+	{
+		m_Frame.m_aSources[index].m_vPosition = position;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Change what a previously added source is doing (0 = silent)
+	//------------------------------------------------------------------------------------------------
+	void SetSourceClass(int index, int classFlags)
+	{
+		m_Frame.m_aSources[index].m_iClassFlags = classFlags;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Advance time by one tick and run the pipeline (one rendered frame per tick)
+	//------------------------------------------------------------------------------------------------
+	void Step(int ticks = 1)
+	{
+		for (int i = 0; i < ticks; i++)
+		{
+			m_Frame.m_fTime = m_Frame.m_fTime + TICK_MS;
+			m_Pipeline.Update();
+			m_Pipeline.UpdateAudio(m_Frame.m_fTime);
+			m_Frame.m_aWeaponFire.Clear();
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Advance to an absolute time (ms since START_TIME) in one tick
+	//------------------------------------------------------------------------------------------------
+	void StepTo(float elapsedMs)
+	{
+		m_Frame.m_fTime = START_TIME + elapsedMs;
+		m_Pipeline.Update();
+		m_Pipeline.UpdateAudio(m_Frame.m_fTime);
+		m_Frame.m_aWeaponFire.Clear();
+	}
+
+#ifndef VSC_NO_WEAPON_MONITOR
+	//------------------------------------------------------------------------------------------------
+	// A shot seen on the next tick only (direction zero = same level all around)
+	//------------------------------------------------------------------------------------------------
+	void FireWeapon(vector position, VSC_WeaponSignature signature, vector direction = vector.Zero)
+	{
+		VSC_WeaponFire fire = new VSC_WeaponFire();
+		fire.m_vPosition = position;
+		fire.m_vDirection = direction;
+		fire.m_fRangeScale = signature.m_fRangeScale;
+		fire.m_fDirectivity = signature.m_fDirectivity;
+		m_Frame.m_aWeaponFire.Insert(fire);
+	}
+#endif
+
+	//------------------------------------------------------------------------------------------------
+	void Explode(vector position)
+	{
+		m_Pipeline.HandleExplosion(position, m_Frame.m_fTime);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Hearing output that remembers the last written range
+//------------------------------------------------------------------------------------------------
+class VSC_TestHearingOutput : VSC_HearingOutput
+{
+	float m_fLastWrittenRange = -1.0;
+
+	//------------------------------------------------------------------------------------------------
+	override protected void Write(float range)
+	{
+		super.Write(range);
+		m_fLastWrittenRange = range;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// AI hearing table without characters: rows stand at a set position, writes are remembered per AI
+// and the table is stepped by hand instead of from the callqueue
+//------------------------------------------------------------------------------------------------
+class VSC_TestAIHearingSystem : VSC_AIHearingSystem
+{
+	ref map<string, vector> m_mOrigins = new map<string, vector>();
+	ref map<string, float> m_mLastWrittenRange = new map<string, float>();
+	ref array<string> m_aDeleted = {}; // AI whose character is gone
+
+	//------------------------------------------------------------------------------------------------
+	// Install as the singleton, so VSC_AIHearingSystem.Destroy shuts it down
+	//------------------------------------------------------------------------------------------------
+	static VSC_TestAIHearingSystem CreateForTest(int updatesPerFrame)
+	{
+		VSC_TestAIHearingSystem system = new VSC_TestAIHearingSystem();
+		s_Instance = system;
+		system.Start(false, updatesPerFrame);
+		return system;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void AddAI(string id, vector origin, VSC_ProtectionProfile profile, float currentTime)
+	{
+		m_mOrigins.Set(id, origin);
+		InsertRow(id, null, null, profile, VSC_TestScenario.ORIGINAL_RANGE, currentTime);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void StepTo(float currentTime)
+	{
+		UpdateTable(currentTime);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Explode(vector position, float currentTime)
+	{
+		DampenAround(position, currentTime);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override protected bool IsRowAlive(int row)
+	{
+		return !m_aDeleted.Contains(m_aIds[row]);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override protected vector GetRowOrigin(int row)
+	{
+		return m_mOrigins.Get(m_aIds[row]);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override protected void WriteRange(int row, float range)
+	{
+		m_mLastWrittenRange.Set(m_aIds[row], range);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+class VSC_TestResult : TestResultBase
+{
+	protected bool m_bSuccess;
+	protected string m_sMessage;
+
+	//------------------------------------------------------------------------------------------------
+	void VSC_TestResult(bool success, string message = string.Empty)
+	{
+		m_bSuccess = success;
+		m_sMessage = message;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override bool Failure()
+	{
+		return !m_bSuccess;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override string FailureText()
+	{
+		return m_sMessage;
+	}
+}
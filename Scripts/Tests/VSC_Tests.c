@@ -0,0 +1,1196 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Autotests
+// Correctness and per-stage time budget checks for the compressor, clock and cooldown, weapon
+// signatures, audio output, acoustic grid, shared tuning profiles, runtime tuning, AI hearing,
+// source tracking and deletion, sector histogram, discovery sweep, refresh scheduling, top-K
+// selection, temporal coherence, learning warm starts, possession handover, suspend/resume,
+// activity gating, the classification queue, source clusters, telemetry reports and filter
+// kernels, driven by synthetic inputs. Run headless with -vscTest (see VSC_TestRunner).
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+class VSC_TestSuite : TestSuite
+{
+}
+
+//------------------------------------------------------------------------------------------------
+// Per-stage budgets in microseconds (average per call)
+//------------------------------------------------------------------------------------------------
+class VSC_TestBudgets
+{
+	static const float PROTECTION_US = 50.0;
+	static const float FILTERING_US = 150.0;
+	static const int BENCH_TICKS = 900;
+
+	//------------------------------------------------------------------------------------------------
+	static float GetTrackingBudget(int sourceCount)
+	{
+		return 100.0 + sourceCount * 10.0;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Collects the first failed check and reports it as the test result
+//------------------------------------------------------------------------------------------------
+class VSC_TestCase : TestBase
+{
+	protected ref VSC_TestScenario m_Scenario = new VSC_TestScenario();
+	protected bool m_bFailed;
+	protected string m_sFailure;
+
+	//------------------------------------------------------------------------------------------------
+	protected void Check(bool condition, string message)
+	{
+		if (condition || m_bFailed)
+			return;
+
+		m_bFailed = true;
+		m_sFailure = message;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void CheckBudget(EVSC_Stage stage, float budgetUs)
+	{
+		float averageUs = m_Scenario.m_Stats.GetAverageMicroseconds(stage);
+		Check(averageUs <= budgetUs, string.Format("%1 took %2 us per call, budget %3 us", VSC_StageStats.GetStageName(stage), averageUs, budgetUs));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Finish()
+	{
+		SetResult(new VSC_TestResult(!m_bFailed, m_sFailure));
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_CompressorOverlappingExplosionsTest : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		m_Scenario.Start(true, false);
+		VSC_ProtectionProcessor protection = m_Scenario.m_Pipeline.GetProtection();
+		VSC_ProtectionProfile profile = m_Scenario.m_ProtectionProfile;
+		float dampenedRange = VSC_TestScenario.ORIGINAL_RANGE * profile.m_fDampenMultiplier;
+
+		m_Scenario.StepTo(0);
+		m_Scenario.Explode("5 0 5");
+		Check(protection.IsDampened(), "Explosion within trigger range did not dampen");
+		Check(m_Scenario.m_Output.GetAppliedRange() == dampenedRange, "Dampening was not applied to the output immediately");
+
+		// Second explosion while still dampened must extend the dampening
+		float overlapMs = profile.m_iDampenDurationMs * 0.75;
+		m_Scenario.StepTo(overlapMs);
+		m_Scenario.Explode("0 0 10");
+
+		m_Scenario.StepTo(profile.m_iDampenDurationMs + overlapMs * 0.5);
+		Check(protection.IsDampened(), "Dampening released before the overlapping explosion's duration elapsed");
+		Check(m_Scenario.m_Output.GetAppliedRange() == dampenedRange, "Output left the dampened range during overlapping explosions");
+
+		m_Scenario.StepTo(profile.m_iDampenDurationMs + overlapMs + VSC_TestScenario.TICK_MS);
+		Check(!protection.IsDampened(), "Dampening did not release after the last explosion's duration");
+
+		// Explosion out of range never dampens
+		m_Scenario.StepTo(10000);
+		m_Scenario.Explode(Vector(0, 0, profile.m_fDampenTriggerRange * 2.0));
+		Check(!protection.IsDampened(), "Explosion outside trigger range dampened");
+
+		m_Scenario.m_Pipeline.Deactivate();
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_ClockTest : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		// Samples within one frame keep the delta, a new time advances it
+		VSC_Clock clock = new VSC_Clock();
+		clock.Sample(2000.0);
+		Check(clock.GetDeltaMs() == 0.0, "First sample has a delta");
+		clock.Sample(2050.0);
+		clock.Sample(2050.0);
+		Check(clock.GetMs() == 2050.0 && clock.GetDeltaMs() == 50.0, string.Format("Repeated sample changed the delta (%1)", clock.GetDeltaMs()));
+		Check(Math.AbsFloat(clock.GetSeconds() - 2.05) < 0.0001 && Math.AbsFloat(clock.GetDeltaSeconds() - 0.05) < 0.0001, "Seconds do not follow milliseconds");
+
+		// The dampening cooldown is configured in seconds and holds back the release for that long,
+		// a second blast within it still dampens
+		m_Scenario.Start(true, false);
+		VSC_ProtectionProcessor protection = m_Scenario.m_Pipeline.GetProtection();
+		VSC_ProtectionProfile profile = m_Scenario.m_ProtectionProfile;
+		float cooldownMs = VSC_Clock.SecondsToMs(profile.m_fDampeningCooldown);
+		Check(profile.m_iDampenDurationMs < cooldownMs, "Default dampening outlasts the cooldown");
+
+		m_Scenario.StepTo(0);
+		m_Scenario.Explode("5 0 5");
+		m_Scenario.StepTo(profile.m_iDampenDurationMs + VSC_TestScenario.TICK_MS);
+		Check(protection.IsDampened(), "Dampening released within the cooldown");
+
+		float secondBlastMs = m_Scenario.m_Pipeline.GetClock().GetMs() - VSC_TestScenario.START_TIME;
+		m_Scenario.Explode("5 0 5");
+		Check(protection.IsDampened(), "Explosion within the cooldown was not dampened");
+		Check(protection.GetDampeningCount() == 1, "Explosion within the cooldown toggled the dampening");
+
+		m_Scenario.StepTo(cooldownMs);
+		Check(protection.IsDampened(), "Explosion within the cooldown did not extend the dampening");
+
+		m_Scenario.StepTo(secondBlastMs + profile.m_iDampenDurationMs + VSC_TestScenario.TICK_MS);
+		Check(!protection.IsDampened(), "Extended dampening did not release");
+
+		m_Scenario.Explode("5 0 5");
+		Check(protection.IsDampened() && protection.GetDampeningCount() == 2, "Explosion after the release did not dampen");
+
+		m_Scenario.m_Pipeline.Deactivate();
+		Finish();
+	}
+}
+
+#ifndef VSC_NO_WEAPON_MONITOR
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_WeaponSignatureTest : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		// One shared entry per prefab and suppressor state, louder calibres carry further
+		VSC_WeaponSignature pistol = VSC_WeaponSignatures.GetSignature("{TEST}pistol.et", EVSC_Calibre.PISTOL, false);
+		VSC_WeaponSignature rifle = VSC_WeaponSignatures.GetSignature("{TEST}rifle.et", EVSC_Calibre.INTERMEDIATE, false);
+		VSC_WeaponSignature suppressedRifle = VSC_WeaponSignatures.GetSignature("{TEST}rifle.et", EVSC_Calibre.INTERMEDIATE, true);
+		VSC_WeaponSignature machineGun = VSC_WeaponSignatures.GetSignature("{TEST}mg.et", EVSC_Calibre.FULL_POWER, false);
+		VSC_WeaponSignature launcher = VSC_WeaponSignatures.GetSignature("{TEST}launcher.et", EVSC_Calibre.HEAVY, false);
+		Check(rifle == VSC_WeaponSignatures.GetSignature("{TEST}rifle.et", EVSC_Calibre.INTERMEDIATE, false), "Signature built twice for the same prefab");
+		Check(suppressedRifle != rifle && suppressedRifle.m_bSuppressed, "Suppressor state shares the unsuppressed entry");
+		Check(rifle.m_fRangeScale == 1.0, "Reference report does not keep the profile trigger range");
+		Check(pistol.m_fRangeScale < rifle.m_fRangeScale && rifle.m_fRangeScale < machineGun.m_fRangeScale && machineGun.m_fRangeScale < launcher.m_fRangeScale, "Range scale does not follow calibre");
+		Check(suppressedRifle.m_fRangeScale < 0.2, string.Format("Suppressed rifle range scale %1", suppressedRifle.m_fRangeScale));
+		Check(launcher.m_fRangeScale <= VSC_WeaponSignatures.MAX_RANGE_SCALE, "Loudest signature exceeds the fire search range");
+
+		m_Scenario.Start(true, false);
+		VSC_ProtectionProcessor protection = m_Scenario.m_Pipeline.GetProtection();
+		VSC_ProtectionProfile profile = m_Scenario.m_ProtectionProfile;
+		float range = profile.m_fWeaponSoundTriggerRange;
+		m_Scenario.Step();
+
+		// A suppressed rifle close by stays below the trigger
+		m_Scenario.FireWeapon(Vector(0, 0, range * 0.3), suppressedRifle);
+		m_Scenario.Step();
+		Check(!protection.IsDampened(), "Suppressed rifle within the trigger range dampened");
+
+		// A heavy weapon beyond the reference range dampens, and longer than the profile duration
+		m_Scenario.FireWeapon(Vector(0, 0, range * 1.5), launcher);
+		m_Scenario.Step();
+		Check(protection.IsDampened(), "Heavy weapon beyond the reference range did not dampen");
+
+		int durationTicks = profile.m_iWeaponSoundDurationMs / VSC_TestScenario.TICK_MS;
+		m_Scenario.Step(durationTicks);
+		Check(protection.IsDampened(), "Heavy weapon dampened no longer than the profile duration");
+
+		m_Scenario.Step(durationTicks * 2);
+		Check(!protection.IsDampened(), "Heavy weapon dampening did not release");
+
+		// Directivity: the same report is heard in front of the muzzle but not behind it
+		vector position = Vector(0, 0, range * 1.5);
+		m_Scenario.FireWeapon(position, machineGun, "0 0 1");
+		m_Scenario.Step();
+		Check(!protection.IsDampened(), "Machine gun firing away from the listener dampened");
+
+		m_Scenario.FireWeapon(position, machineGun, "0 0 -1");
+		m_Scenario.Step();
+		Check(protection.IsDampened(), "Machine gun firing towards the listener did not dampen");
+
+		m_Scenario.m_Pipeline.Deactivate();
+		Finish();
+	}
+}
+#endif
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_AudioOutputTest : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		m_Scenario.Start(true, false);
+		VSC_ProtectionProcessor protection = m_Scenario.m_Pipeline.GetProtection();
+		VSC_AudioOutput audio = m_Scenario.m_Audio;
+		m_Scenario.Step(2);
+		Check(audio.GetAppliedVolume() == 1.0 && audio.GetWriteCount() == 0, "Boost raised the mix over the user's volume");
+
+		// Attenuation lands in the same frame as the explosion
+		m_Scenario.Explode("5 0 5");
+		Check(audio.GetAppliedVolume() == m_Scenario.m_ProtectionProfile.m_fDampenMultiplier, "Explosion was not attenuated in the same frame");
+
+		for (int i = 0; i < 20 && protection.IsDampened(); i++)
+		{
+			m_Scenario.Step();
+		}
+
+		// Release is smoothed over several frames, then settles exactly on the user's volume
+		float releasing = audio.GetAppliedVolume();
+		Check(releasing > m_Scenario.m_ProtectionProfile.m_fDampenMultiplier && releasing < 1.0, string.Format("Release was not smoothed (volume %1)", releasing));
+
+		m_Scenario.Step(30);
+		Check(audio.GetAppliedVolume() == 1.0, string.Format("Volume did not return to the user's level (%1)", audio.GetAppliedVolume()));
+		int writes = audio.GetWriteCount();
+		m_Scenario.Step(20);
+		Check(audio.GetWriteCount() == writes, "Settled audio output kept writing");
+
+		// Deactivating while attenuated puts the user's volume back
+		m_Scenario.Explode("5 0 5");
+		writes = audio.GetWriteCount();
+		m_Scenario.m_Pipeline.Deactivate();
+		Check(audio.GetWriteCount() == writes + 1, "User's volume was not restored on deinit");
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_AcousticGridTest : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		// Cells are baked once and shared by every position inside them
+		VSC_AcousticGrid grid = new VSC_AcousticGrid(3);
+		grid.Lookup("0.5 0 0.5");
+		grid.Lookup("7.5 10 7.5");
+		Check(grid.GetBakeCount() == 1, string.Format("Same cell baked %1 times", grid.GetBakeCount()));
+
+		grid.Lookup("-1 0 -1");
+		grid.Lookup("20 0 0");
+		Check(grid.GetBakeCount() == 3 && grid.GetCount() == 3, "Separate cells were not baked separately");
+
+		// Full cache evicts the least recently used cell
+		grid.Lookup("1 0 1");
+		grid.Lookup("40 0 0");
+		Check(grid.GetCount() == 3, string.Format("Cache grew to %1 cells over its capacity", grid.GetCount()));
+		grid.Lookup("1 0 1");
+		Check(grid.GetBakeCount() == 4, "Recently used cell was evicted");
+		grid.Lookup("-1 0 -1");
+		Check(grid.GetBakeCount() == 5, "Least recently used cell was kept");
+
+		// Enclosed, reverberant surroundings: less boost, stronger dampening
+		m_Scenario.m_Frame.m_Acoustics.Set(1.0, 0.0, 1.0);
+		m_Scenario.Start(true, false);
+		m_Scenario.Step();
+		VSC_ProtectionProfile profile = m_Scenario.m_ProtectionProfile;
+		float range = m_Scenario.m_Output.GetAppliedRange();
+		Check(range > VSC_TestScenario.ORIGINAL_RANGE && range < VSC_TestScenario.ORIGINAL_RANGE * profile.m_fBoostMultiplier, string.Format("Indoor boost not reduced (range %1)", range));
+
+		m_Scenario.Explode("5 0 5");
+		range = m_Scenario.m_Output.GetAppliedRange();
+		Check(range < VSC_TestScenario.ORIGINAL_RANGE * profile.m_fDampenMultiplier, string.Format("Indoor dampening not strengthened (range %1)", range));
+
+		m_Scenario.m_Pipeline.Deactivate();
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_SharedProfilesTest : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		// Headgear without a config shares one default instance
+		VSC_ProtectionProfile protection = VSC_ProfileRegistry.GetProtectionProfile(string.Empty);
+		VSC_BOSSAProfile bossa = VSC_ProfileRegistry.GetBOSSAProfile(string.Empty);
+		Check(protection && protection == VSC_ProfileRegistry.GetProtectionProfile(string.Empty), "Default protection profile is not shared");
+		Check(bossa && bossa == VSC_ProfileRegistry.GetBOSSAProfile(string.Empty), "Default BOSSA profile is not shared");
+
+		// A server preset replaces the tuning it carries and leaves the rest alone
+		VSC_TuningPreset preset = new VSC_TuningPreset();
+		preset.m_Protection = new VSC_ProtectionProfile();
+		VSC_ProfileRegistry.SetPreset(preset);
+		Check(VSC_ProfileRegistry.GetProtectionProfile(string.Empty) == preset.m_Protection, "Preset protection profile not used");
+		Check(VSC_ProfileRegistry.GetBOSSAProfile(string.Empty) == bossa, "Preset without BOSSA tuning replaced the BOSSA profile");
+
+		VSC_ProfileRegistry.SetPreset(null);
+		Check(VSC_ProfileRegistry.GetProtectionProfile(string.Empty) == protection, "Defaults not restored after clearing the preset");
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_RuntimeTuningTest : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		// Parameters are found by name without the member prefix, case-insensitive
+		VSC_BOSSAProfile tuned = new VSC_BOSSAProfile();
+		array<string> parameters = {};
+		VSC_Tuning.GetParameters(tuned, parameters);
+		Check(parameters.Contains("MaxTrackedSources"), "MaxTrackedSources is not a tuning parameter");
+		Check(VSC_Tuning.Set(tuned, "attentionconeangle", "90"), "Cone angle could not be set");
+		Check(tuned.m_fAttentionConeAngle == 90.0, "Cone angle not written");
+		Check(VSC_Tuning.Get(tuned, "AttentionConeAngle").ToFloat() == 90.0, "Cone angle not read back");
+		Check(!VSC_Tuning.Set(tuned, "NoSuchParameter", "1") && VSC_Tuning.Get(tuned, "NoSuchParameter").IsEmpty(), "Unknown parameter accepted");
+
+		VSC_BOSSAProfile copy = new VSC_BOSSAProfile();
+		VSC_Tuning.Copy(tuned, copy);
+		Check(copy.m_fAttentionConeAngle == 90.0, "Copy missed the cone angle");
+
+		// Lowering the source cap on a running pipeline evicts at once and keeps everything else
+		m_Scenario.AddSources(20, 5.0, 40.0);
+		m_Scenario.Start();
+		m_Scenario.Step(30);
+
+		VSC_BOSSAProcessor bossa = m_Scenario.m_Pipeline.GetBOSSA();
+		Check(bossa.GetTrackedSourceCount() == m_Scenario.m_BOSSAProfile.m_iMaxTrackedSources, "Source cap not reached before retuning");
+
+		copy.m_iMaxTrackedSources = 4;
+		m_Scenario.m_Pipeline.SetProfiles(null, copy);
+		Check(bossa.GetTrackedSourceCount() == 4, string.Format("Tracked %1 sources after lowering the cap to 4", bossa.GetTrackedSourceCount()));
+		Check(m_Scenario.m_Pipeline.GetBOSSAProfile() == copy, "Pipeline did not take the tuned profile");
+		Check(m_Scenario.m_Pipeline.GetProtectionProfile() == m_Scenario.m_ProtectionProfile, "Null profile replaced the protection tuning");
+		Check(m_Scenario.m_BOSSAProfile.m_iMaxTrackedSources == 10, "Retuning modified the original profile");
+
+		m_Scenario.Step(10);
+		Check(bossa.GetTrackedSourceCount() <= 4, "Cap exceeded after retuning");
+		Check(m_Scenario.m_Pipeline.IsActive() && m_Scenario.m_Pipeline.IsAttached(), "Retuning stopped the pipeline");
+
+		m_Scenario.m_Pipeline.Deactivate();
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_RangeRestoredOnDeinitTest : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		m_Scenario.AddSources(10);
+		m_Scenario.Start();
+		m_Scenario.Step(10);
+		m_Scenario.Explode("3 0 3");
+		m_Scenario.Step();
+
+		Check(m_Scenario.m_Output.m_fLastWrittenRange != VSC_TestScenario.ORIGINAL_RANGE, "Pipeline never changed the auditory range");
+
+		m_Scenario.m_Pipeline.Deactivate();
+		Check(m_Scenario.m_Output.m_fLastWrittenRange == VSC_TestScenario.ORIGINAL_RANGE, "Auditory range was not restored on deinit");
+		Check(!m_Scenario.m_Pipeline.IsActive(), "Pipeline still active after deinit");
+
+		// Further ticks after deinit must not touch the output
+		int writes = m_Scenario.m_Output.GetWriteCount();
+		m_Scenario.Step(5);
+		Check(m_Scenario.m_Output.GetWriteCount() == writes, "Output written after deinit");
+
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_AIHearingSystemTest : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		VSC_ProtectionProfile profile = m_Scenario.m_ProtectionProfile;
+		float boostedRange = VSC_TestScenario.ORIGINAL_RANGE * profile.m_fBoostMultiplier;
+		float dampenedRange = VSC_TestScenario.ORIGINAL_RANGE * profile.m_fDampenMultiplier;
+		float spacing = profile.m_fDampenTriggerRange * 0.4;
+
+		// Registered AI are boosted at once, not when the round-robin reaches them
+		VSC_TestAIHearingSystem system = VSC_TestAIHearingSystem.CreateForTest(2);
+		for (int i = 0; i < 6; i++)
+		{
+			system.AddAI("ai" + i, Vector(i * spacing, 0, 0), profile, 0.0);
+		}
+
+		Check(system.GetCount() == 6 && system.GetAppliedRange("ai5") == boostedRange, "Registered AI not boosted at once");
+
+		// A deleted character is swap-removed, the last row moves into its slot and keeps its state
+		system.m_aDeleted.Insert("ai0");
+		system.StepTo(50.0);
+		Check(system.GetCount() == 5 && system.GetAppliedRange("ai0") < 0.0, "Deleted AI not removed");
+		Check(system.m_mLastWrittenRange.Get("ai0") == VSC_TestScenario.ORIGINAL_RANGE, "Deleted AI's range not restored");
+		Check(system.GetAppliedRange("ai5") == boostedRange && system.GetAppliedRange("ai4") == boostedRange, "Swapped row lost its state");
+
+		// An explosion dampens the AI in its trigger range at once, the rest stay boosted
+		system.Explode(vector.Zero, 100.0);
+		Check(system.GetAppliedRange("ai1") == dampenedRange && system.GetAppliedRange("ai2") == dampenedRange, "AI in range not dampened at once");
+		Check(system.GetAppliedRange("ai3") == boostedRange, "AI out of range dampened");
+
+		// A second blast extends the dampening past the first one's end
+		float cooldownMs = VSC_Clock.SecondsToMs(profile.m_fDampeningCooldown);
+		float firstEnd = 100.0 + Math.Max(profile.m_iDampenDurationMs, cooldownMs);
+		float secondBlast = firstEnd - 50.0;
+		system.StepTo(secondBlast);
+		system.Explode(vector.Zero, secondBlast);
+		system.StepTo(firstEnd + 50.0);
+		Check(system.GetAppliedRange("ai1") == dampenedRange && system.GetAppliedRange("ai2") == dampenedRange, "Second explosion did not extend the dampening");
+
+		// Every expired dampening is released in one frame, whatever the round-robin cursor
+		system.StepTo(secondBlast + profile.m_iDampenDurationMs);
+		Check(system.GetAppliedRange("ai1") == boostedRange && system.GetAppliedRange("ai2") == boostedRange, "Expired dampening waited for the round-robin");
+
+		// Destroy restores every AI's original range
+		VSC_AIHearingSystem.Destroy();
+		Check(!VSC_AIHearingSystem.GetInstance() && system.GetCount() == 0, "System still registered after destroy");
+		for (int j = 1; j < 6; j++)
+		{
+			Check(system.m_mLastWrittenRange.Get("ai" + j) == VSC_TestScenario.ORIGINAL_RANGE, "AI range not restored on destroy");
+		}
+
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_FilterKernelTest : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		// Footsteps straight ahead are enhanced
+		VSC_TestScenario front = new VSC_TestScenario();
+		front.AddSourceAt("0 0 8");
+		front.AddSourceAt("1 0 12");
+		front.Start(false, true);
+		front.Step(12);
+		float frontGain = front.m_Pipeline.GetBOSSA().GetGain();
+		Check(frontGain > 1.0, string.Format("Front footsteps were not enhanced (gain %1)", frontGain));
+
+		// The same sources behind the listener get no attention boost
+		VSC_TestScenario back = new VSC_TestScenario();
+		back.AddSourceAt("0 0 -8");
+		back.AddSourceAt("1 0 -12");
+		back.Start(false, true);
+		back.Step(12);
+		float backGain = back.m_Pipeline.GetBOSSA().GetGain();
+		Check(backGain < frontGain, string.Format("Background sources gained as much as front sources (%1 >= %2)", backGain, frontGain));
+
+		// No sources, no change
+		m_Scenario.Start(false, true);
+		m_Scenario.Step(12);
+		Check(m_Scenario.m_Pipeline.GetBOSSA().GetGain() == 1.0, "Gain changed without any sources");
+
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_SectorHistogramTest : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		// Raw angles, so bins follow a turn at once
+		m_Scenario.m_BOSSAProfile.m_bUseTemporalCoherence = false;
+		m_Scenario.AddSourceAt("0 0 8"); // Ahead, near
+		m_Scenario.AddSourceAt("0 0 -30"); // Behind, mid
+		m_Scenario.AddSourceAt("-40 0 0"); // Left, mid
+		m_Scenario.AddSourceAt("60 0 0"); // Right, far
+		m_Scenario.Start(false, true);
+		m_Scenario.Step(12);
+
+		VSC_BOSSAProcessor bossa = m_Scenario.m_Pipeline.GetBOSSA();
+		VSC_SectorHistogram histogram = bossa.GetSectorHistogram();
+		Check(histogram.GetTotalCount() == bossa.GetTrackedSourceCount(), string.Format("Histogram holds %1 sources, tracker %2", histogram.GetTotalCount(), bossa.GetTrackedSourceCount()));
+		Check(histogram.GetBinCount(VSC_SectorHistogram.GetSector(0), 0) == 1, "Source ahead not binned ahead");
+		Check(histogram.GetBinCount(VSC_SectorHistogram.GetSector(180), 1) == 1, "Source behind not binned behind");
+		Check(histogram.GetBinCount(VSC_SectorHistogram.GetSector(-90), 1) == 1, "Source on the left not binned left");
+		Check(histogram.GetBinCount(VSC_SectorHistogram.GetSector(90), 2) == 1, "Source on the right not binned right");
+
+		// Background is weighted by distance band, the far source counts less than its own
+		int right = VSC_SectorHistogram.GetSector(90);
+		float farBackground = histogram.GetBinBackground(right, 2);
+		Check(farBackground > 0.0 && Math.AbsFloat(histogram.GetBackground(right) - farBackground * VSC_SectorHistogram.FAR_BAND_BACKGROUND_WEIGHT) < 0.0001, "Far band background not weighted down");
+
+		// An evicted source takes its whole contribution with it
+		int rear = VSC_SectorHistogram.GetSector(180);
+		m_Scenario.SetSourceClass(1, 0);
+		m_Scenario.Step(25);
+		Check(!bossa.IsTracking("test1"), "Silent source still tracked");
+		Check(histogram.GetCount(rear) == 0 && histogram.GetBackground(rear) == 0.0 && histogram.GetBinBackground(rear, 1) == 0.0, "Evicted source left a contribution behind");
+		Check(histogram.GetTotalCount() == bossa.GetTrackedSourceCount(), "Histogram out of step with the tracker after eviction");
+
+		// Turning around re-bins from the cached directions
+		m_Scenario.m_Frame.m_vListenerForward = "0 0 -1";
+		m_Scenario.Step(3);
+		Check(histogram.GetBinCount(VSC_SectorHistogram.GetSector(180), 0) == 1, "Source ahead not moved behind after turning around");
+		Check(histogram.GetBinCount(VSC_SectorHistogram.GetSector(90), 1) == 1, "Source on the left not moved right after turning around");
+
+		m_Scenario.m_Pipeline.Deactivate();
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_SourceDeletionTest : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		m_Scenario.AddSources(6, 5.0, 40.0);
+		m_Scenario.Start(false, true);
+		m_Scenario.Step(12);
+
+		VSC_BOSSAProcessor bossa = m_Scenario.m_Pipeline.GetBOSSA();
+		int tracked = bossa.GetTrackedSourceCount();
+		Check(tracked == 6, string.Format("Tracked %1 of 6 sources", tracked));
+
+		// Deleted entities leave at once, without waiting for a refresh
+		m_Scenario.SetSourceClass(1, 0);
+		m_Scenario.m_Pipeline.OnSourceDeleted("test1");
+		Check(!bossa.IsTracking("test1"), "Deleted source still tracked");
+		Check(bossa.GetTrackedSourceCount() == tracked - 1, "Deletion removed the wrong number of sources");
+		Check(bossa.GetSectorHistogram().GetTotalCount() == tracked - 1, "Deleted source left in the sector histogram");
+
+		// Untracked and repeated deletions are ignored
+		m_Scenario.m_Pipeline.OnSourceDeleted("test1");
+		m_Scenario.m_Pipeline.OnSourceDeleted("unknown");
+		Check(bossa.GetTrackedSourceCount() == tracked - 1, "Deleting an untracked source changed the tracker");
+
+		// Slots stay consistent after unordered removal
+		array<ref VSC_TrackedSoundSource> sources = bossa.GetTrackedSources();
+		for (int i = 0; i < sources.Count(); i++)
+		{
+			Check(sources[i].m_iTrackedIndex == i, string.Format("Source %1 holds slot %2, stored at %3", sources[i].m_sId, sources[i].m_iTrackedIndex, i));
+		}
+
+		m_Scenario.Step(30);
+		Check(!bossa.IsTracking("test1") && bossa.GetTrackedSourceCount() == tracked - 1, "Remaining sources disturbed by the deletion");
+
+		m_Scenario.m_Pipeline.Deactivate();
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_DiscoverySweepTest : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		const float RADIUS = 150.0;
+		const int SOURCE_COUNT = 300;
+
+		// Sources all around the listener, some of them up on a slope or down in a valley
+		m_Scenario.AddSources(SOURCE_COUNT, 1.0, RADIUS - 10.0);
+		for (int i = 0; i < SOURCE_COUNT; i += 7)
+		{
+			vector position = m_Scenario.m_Frame.m_aSources[i].m_vPosition;
+			position[1] = VSC_DiscoverySweep.VERTICAL_RANGE * (((i / 7) % 3) - 1);
+			m_Scenario.MoveSource(i, position);
+		}
+
+		// One full sweep reports every source exactly once, in slices much smaller than the whole
+		VSC_DiscoverySweep sweep = new VSC_DiscoverySweep();
+		map<string, int> seen = new map<string, int>();
+		array<ref VSC_SourceSample> samples = {};
+		int largestSlice = 0;
+		for (int region = 0; region < sweep.GetRegionCount(); region++)
+		{
+			samples.Clear();
+			bool finished = sweep.Step(m_Scenario.m_Input, RADIUS, 1, samples);
+			Check(finished == (region == sweep.GetRegionCount() - 1), string.Format("Sweep finished after region %1", region));
+			largestSlice = Math.Max(largestSlice, samples.Count());
+
+			foreach (VSC_SourceSample sample : samples)
+			{
+				seen.Set(sample.m_sId, seen.Get(sample.m_sId) + 1);
+			}
+		}
+
+		Check(seen.Count() == SOURCE_COUNT, string.Format("Sweep found %1 of %2 sources", seen.Count(), SOURCE_COUNT));
+		foreach (string id, int count : seen)
+		{
+			Check(count == 1, string.Format("%1 reported %2 times in one sweep", id, count));
+		}
+
+		Check(largestSlice * 3 < SOURCE_COUNT, string.Format("Largest region returned %1 of %2 sources", largestSlice, SOURCE_COUNT));
+		Check(sweep.GetNextRegion() == 0, "Next sweep does not start from the central disc");
+
+		// The pipeline covers its whole search range within one sweep, two regions per tick
+		VSC_TestScenario scenario = new VSC_TestScenario();
+		scenario.AddSources(8, 5.0, 140.0);
+		scenario.Start();
+		scenario.Step(Math.Ceil(sweep.GetRegionCount() / 2.0));
+		Check(scenario.m_Pipeline.GetBOSSA().GetTrackedSourceCount() == 8, string.Format("Tracked %1 of 8 sources after one sweep", scenario.m_Pipeline.GetBOSSA().GetTrackedSourceCount()));
+
+		scenario.m_Pipeline.Deactivate();
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_RefreshSchedulingTest : VSC_TestCase
+{
+	static const int TICKS = 60;
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		// A far, static source settles at the slowest refresh rate
+		VSC_TestScenario far = new VSC_TestScenario();
+		far.AddSourceAt("0 0 100");
+		far.Start(false, true);
+		far.Step(TICKS);
+		int farRefreshes = far.m_Pipeline.GetBOSSA().GetRefreshCount();
+		Check(farRefreshes > 0, "Far source was never tracked");
+		Check(farRefreshes <= 6, string.Format("Far static source refreshed %1 times in %2 ticks", farRefreshes, TICKS));
+
+		// A near source circling the listener at running speed is refreshed every tick
+		m_Scenario.AddSourceAt("0 0 3");
+		m_Scenario.Start(false, true);
+		for (int i = 1; i <= TICKS; i++)
+		{
+			float angle = i * 0.1;
+			m_Scenario.MoveSource(0, Vector(Math.Sin(angle) * 3.0, 0, Math.Cos(angle) * 3.0));
+			m_Scenario.Step();
+		}
+
+		int nearRefreshes = m_Scenario.m_Pipeline.GetBOSSA().GetRefreshCount();
+		Check(nearRefreshes >= TICKS - 10, string.Format("Near moving source refreshed only %1 times in %2 ticks", nearRefreshes, TICKS));
+
+		far.m_Pipeline.Deactivate();
+		m_Scenario.m_Pipeline.Deactivate();
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_TopKSelectionTest : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		// Fill the table with distant talking characters
+		m_Scenario.AddSources(30, 80.0, 120.0, EVSC_SourceClass.CHARACTER | EVSC_SourceClass.VOICE);
+		m_Scenario.Start(false, true);
+		m_Scenario.Step(12);
+
+		int cap = m_Scenario.m_BOSSAProfile.m_iMaxTrackedSources;
+		VSC_BOSSAProcessor bossa = m_Scenario.m_Pipeline.GetBOSSA();
+		Check(bossa.GetTrackedSourceCount() == cap, string.Format("Tracked %1 of 30 sources, cap is %2", bossa.GetTrackedSourceCount(), cap));
+
+		// A close footstep source must displace one of them within a sweep
+		m_Scenario.AddSourceAt("2 0 8");
+		m_Scenario.Step(10);
+		Check(bossa.IsTracking("test30"), "Close footsteps were not selected over distant voices");
+		Check(bossa.GetTrackedSourceCount() == cap, string.Format("Tracked %1 sources after eviction, cap is %2", bossa.GetTrackedSourceCount(), cap));
+
+		m_Scenario.m_Pipeline.Deactivate();
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_TemporalCoherenceTest : VSC_TestCase
+{
+	static const int TICKS = 90;
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		VSC_TestScenario raw = new VSC_TestScenario();
+		raw.m_BOSSAProfile.m_bUseTemporalCoherence = false;
+		int rawWrites = RunJitter(raw);
+
+		int smoothedWrites = RunJitter(m_Scenario);
+		Check(smoothedWrites * 2 < rawWrites, string.Format("Temporal coherence did not stabilise the output (%1 writes, %2 without)", smoothedWrites, rawWrites));
+
+		// The smoothed angle settles outside the cone, so the persistent source is suppressed
+		float persistentGain = m_Scenario.m_Pipeline.GetBOSSA().GetGain();
+		Check(persistentGain < 1.0, string.Format("Persistent background source was not suppressed (gain %1)", persistentGain));
+
+		raw.m_Pipeline.Deactivate();
+		m_Scenario.m_Pipeline.Deactivate();
+		Finish();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Footsteps jittering across the attention cone edge every tick, returns the output writes
+	//------------------------------------------------------------------------------------------------
+	protected int RunJitter(VSC_TestScenario scenario)
+	{
+		scenario.AddSourceAt("0 0 8");
+		scenario.Start(false, true);
+
+		for (int i = 0; i < TICKS; i++)
+		{
+			float angle = 15.0;
+			if (i % 2)
+				angle = 35.0;
+
+			angle *= Math.DEG2RAD;
+			scenario.MoveSource(0, Vector(Math.Sin(angle) * 8.0, 0, Math.Cos(angle) * 8.0));
+			scenario.Step();
+		}
+
+		return scenario.m_Output.GetWriteCount();
+	}
+}
+
+#ifndef VSC_NO_ADAPTIVE_LEARNING
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_LearningWarmStartTest : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		VSC_LearnedState state = new VSC_LearnedState();
+		state.m_bValid = true;
+		state.m_fAttentionAngle = 70.0;
+		state.m_fEnhancementLevel = m_Scenario.m_BOSSAProfile.m_fFrontEnhancementMultiplier;
+
+		m_Scenario.m_LearnedState = state;
+		m_Scenario.m_BOSSAProfile.m_bAdaptiveLearning = true;
+		m_Scenario.AddSourceAt("0 0 10");
+		m_Scenario.Start(false, true);
+
+		VSC_BOSSAProcessor bossa = m_Scenario.m_Pipeline.GetBOSSA();
+		Check(bossa.GetLearnedAttentionAngle() == 70.0, string.Format("Learning did not resume from the saved angle (%1)", bossa.GetLearnedAttentionAngle()));
+
+		// Learning carries on from there and is published back to the shared state
+		m_Scenario.Step(30);
+		Check(state.m_iUpdateCount > 0, "Learning steps were not published to the shared state");
+		Check(state.m_fAttentionAngle < 70.0, string.Format("Learned angle did not move towards the source ahead (%1)", state.m_fAttentionAngle));
+		Check(state.m_fAttentionAngle == bossa.GetLearnedAttentionAngle(), "Shared state lags the processor");
+
+		m_Scenario.m_Pipeline.Deactivate();
+		Finish();
+	}
+}
+#endif
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_PossessionHandoverTest : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		m_Scenario.AddSources(10, 5.0, 40.0);
+		m_Scenario.Start();
+		m_Scenario.Step(12);
+
+		VSC_Pipeline pipeline = m_Scenario.m_Pipeline;
+		int tracked = pipeline.GetBOSSA().GetTrackedSourceCount();
+		Check(tracked > 0, "No sources tracked before the handover");
+
+		// Losing the character restores its hearing and stops writing
+		pipeline.Detach();
+		Check(m_Scenario.m_Output.m_fLastWrittenRange == VSC_TestScenario.ORIGINAL_RANGE, "Auditory range was not restored on detach");
+		int writes = m_Scenario.m_Output.GetWriteCount();
+		m_Scenario.Step(5);
+		Check(m_Scenario.m_Output.GetWriteCount() == writes, "Detached output was written");
+
+		// The next character is live immediately, with the sources already known
+		VSC_TestHearingOutput nextOutput = new VSC_TestHearingOutput();
+		pipeline.Attach(nextOutput, 80.0);
+		Check(nextOutput.GetWriteCount() == 1, "New character's hearing was not applied on attach");
+		Check(pipeline.GetBOSSA().GetTrackedSourceCount() == tracked, "Tracked sources were lost across the handover");
+
+		m_Scenario.Step();
+		Check(pipeline.GetBOSSA().GetTrackedSourceCount() > 0, "Sources dropped after re-validation");
+
+		pipeline.Deactivate();
+		Check(nextOutput.m_fLastWrittenRange == 80.0, "New character's range was not restored on deinit");
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_SuspendResumeTest : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		m_Scenario.AddSources(5, 5.0, 40.0);
+		m_Scenario.Start(false, true);
+		m_Scenario.Step(12);
+
+		VSC_Pipeline pipeline = m_Scenario.m_Pipeline;
+		VSC_BOSSAProcessor bossa = pipeline.GetBOSSA();
+		int tracked = bossa.GetTrackedSourceCount();
+
+		// Five seconds on the map: nothing runs, nothing is written
+		pipeline.Detach();
+		int refreshes = bossa.GetRefreshCount();
+		m_Scenario.Step(100);
+		Check(bossa.GetRefreshCount() == refreshes, "Suspended pipeline kept refreshing sources");
+
+		// Resume re-validates every tracked source on the first tick
+		pipeline.Attach(m_Scenario.m_Output, VSC_TestScenario.ORIGINAL_RANGE);
+		m_Scenario.Step();
+		Check(bossa.GetRefreshCount() - refreshes >= tracked, string.Format("Only %1 of %2 sources re-validated on resume", bossa.GetRefreshCount() - refreshes, tracked));
+
+		// During the burst a new source is found on the very next tick
+		m_Scenario.AddSourceAt("0 0 6");
+		m_Scenario.Step();
+		Check(bossa.IsTracking("test5"), "Source appearing after resume was not found during the burst");
+
+		pipeline.Deactivate();
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_ActivityGatingTest : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		m_Scenario.AddSourceAt("0 0 10");
+		m_Scenario.AddSourceAt("5 0 10");
+		m_Scenario.AddSourceAt("-5 0 30", 0); // Idle character
+		m_Scenario.Start(false, true);
+		m_Scenario.Step(12);
+
+		VSC_BOSSAProcessor bossa = m_Scenario.m_Pipeline.GetBOSSA();
+		Check(bossa.IsTracking("test0") && bossa.IsTracking("test1"), "Walking characters were not tracked");
+		Check(!bossa.IsTracking("test2"), "Silent character entered the tracker");
+
+		// One stops, the other stands still and talks - both are seen at their next refresh
+		m_Scenario.SetSourceClass(0, 0);
+		m_Scenario.SetSourceClass(1, EVSC_SourceClass.CHARACTER | EVSC_SourceClass.VOICE);
+		m_Scenario.Step(25);
+		Check(!bossa.IsTracking("test0"), "Character that went quiet is still tracked");
+		Check(bossa.IsTracking("test1"), "Talking character was dropped");
+
+		foreach (VSC_TrackedSoundSource source : bossa.GetTrackedSources())
+		{
+			if (source.m_sId == "test1")
+				Check(!source.m_bIsFootstep && source.m_bIsImportant, "Talking character kept its footstep classification");
+		}
+
+		// The idle character starts walking
+		m_Scenario.SetSourceClass(2, EVSC_SourceClass.CHARACTER | EVSC_SourceClass.MOVEMENT);
+		m_Scenario.Step(12);
+		Check(bossa.IsTracking("test2"), "Character that started walking was not tracked");
+
+		m_Scenario.m_Pipeline.Deactivate();
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_ClassificationQueueTest : VSC_TestCase
+{
+	static const int ARRIVALS = 100;
+	static const int BUDGET = 32;
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		// A burst of first contacts, each found again by overlapping queries while it waits
+		VSC_ClassificationQueue queue = new VSC_ClassificationQueue();
+		EntityID entityId;
+		for (int i = 0; i < ARRIVALS; i++)
+		{
+			queue.Enqueue("entity" + i, entityId);
+			queue.Enqueue("entity" + i, entityId);
+		}
+
+		Check(queue.Count() == ARRIVALS, string.Format("%1 queued for %2 entities", queue.Count(), ARRIVALS));
+
+		// Drained in arrival order, never more than the budget per tick, nothing lost
+		array<ref VSC_SourceSample> batch = {};
+		int taken = 0;
+		int ticks = 0;
+		while (queue.Count() > 0 && ticks < ARRIVALS)
+		{
+			queue.Take(BUDGET, batch);
+			Check(batch.Count() <= BUDGET, string.Format("%1 classified in one tick", batch.Count()));
+			foreach (VSC_SourceSample sample : batch)
+			{
+				Check(sample.m_sId == "entity" + taken, string.Format("%1 classified out of order", sample.m_sId));
+				Check(!queue.IsPending(sample.m_sId), "Classified entity still pending");
+				taken++;
+			}
+
+			batch.Clear();
+			ticks++;
+		}
+
+		Check(taken == ARRIVALS, string.Format("%1 of %2 entities classified", taken, ARRIVALS));
+		Check(ticks == (ARRIVALS + BUDGET - 1) / BUDGET, string.Format("Burst took %1 ticks", ticks));
+
+		// An entity seen again after its turn is queued again
+		Check(queue.Enqueue("entity0", entityId), "Classified entity could not be queued again");
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_SourceClusterTest : VSC_TestCase
+{
+	static const int NEAR_COUNT = 10;
+	static const int FIGHTERS = 40;
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		// A full top-K of near footsteps, and a firefight ahead in a single grid cell
+		m_Scenario.m_BOSSAProfile.m_iMaxTrackedSources = NEAR_COUNT;
+		m_Scenario.AddSources(NEAR_COUNT, 5.0, 20.0);
+		for (int i = 0; i < FIGHTERS; i++)
+		{
+			m_Scenario.AddSourceAt(Vector(5.0 + (i % 8) * 5.0, 0, 105.0 + (i / 8) * 8.0));
+		}
+
+		m_Scenario.Start(false, true);
+		m_Scenario.Step(12);
+
+		VSC_BOSSAProcessor bossa = m_Scenario.m_Pipeline.GetBOSSA();
+		VSC_SectorHistogram histogram = bossa.GetSectorHistogram();
+		Check(bossa.GetTrackedSourceCount() == NEAR_COUNT, string.Format("Tracked %1 sources, cap is %2", bossa.GetTrackedSourceCount(), NEAR_COUNT));
+		foreach (VSC_TrackedSoundSource source : bossa.GetTrackedSources())
+		{
+			Check(source.m_fDistance < VSC_SectorHistogram.MID_BAND_DISTANCE, string.Format("Distant %1 holds a slot over a near source", source.m_sId));
+		}
+
+		// The firefight is one virtual source at its centroid, with the intensity of all its members
+		Check(bossa.GetClusteredSourceCount() == FIGHTERS, string.Format("%1 of %2 distant sources clustered", bossa.GetClusteredSourceCount(), FIGHTERS));
+		CheckCluster(bossa, "22.5 0 121", "ahead");
+		Check(histogram.GetTotalCount() == NEAR_COUNT + 1, string.Format("Histogram holds %1 sources, expected the near ones and one cluster", histogram.GetTotalCount()));
+
+		// Members that move to another cell take their contribution with them
+		for (int j = 0; j < FIGHTERS; j++)
+		{
+			m_Scenario.MoveSource(NEAR_COUNT + j, Vector(105.0 + (j / 8) * 8.0, 0, 5.0 + (j % 8) * 5.0));
+		}
+
+		m_Scenario.Step(10);
+		Check(bossa.GetClusteredSourceCount() == FIGHTERS, string.Format("%1 of %2 sources clustered after moving", bossa.GetClusteredSourceCount(), FIGHTERS));
+		CheckCluster(bossa, "121 0 22.5", "on the right");
+		Check(histogram.GetTotalCount() == NEAR_COUNT + 1, "Emptied cluster left in the histogram");
+
+		// A fight that falls silent expires, cluster and all
+		for (int k = 0; k < FIGHTERS; k++)
+		{
+			m_Scenario.SetSourceClass(NEAR_COUNT + k, 0);
+		}
+
+		m_Scenario.Step(30);
+		Check(bossa.GetClusteredSourceCount() == 0 && bossa.GetSourceClusters().Count() == 0, string.Format("%1 silent sources still clustered", bossa.GetClusteredSourceCount()));
+		Check(histogram.GetTotalCount() == bossa.GetTrackedSourceCount(), "Expired cluster left in the histogram");
+
+		m_Scenario.m_Pipeline.Deactivate();
+		Finish();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void CheckCluster(VSC_BOSSAProcessor bossa, vector centroid, string where)
+	{
+		array<ref VSC_SourceCluster> clusters = bossa.GetSourceClusters();
+		Check(clusters.Count() == 1, string.Format("Firefight %1 split into %2 clusters", where, clusters.Count()));
+		if (clusters.Count() == 0)
+			return;
+
+		VSC_SourceCluster cluster = clusters[0];
+		Check(cluster.m_iMemberCount == FIGHTERS, string.Format("Cluster %1 holds %2 members", where, cluster.m_iMemberCount));
+		Check(vector.Distance(cluster.GetCentroid(), centroid) < 0.1, string.Format("Cluster %1 centred at %2, expected %3", where, cluster.GetCentroid(), centroid));
+		Check(cluster.m_fIntensity >= FIGHTERS / (1.0 + 15.0), string.Format("Cluster %1 intensity %2 is not the sum of its members", where, cluster.m_fIntensity));
+
+		float azimuth = Math.Atan2(centroid[0], centroid[2]) * Math.RAD2DEG;
+		int bin = VSC_SectorHistogram.GetSector(azimuth) * VSC_SectorHistogram.BAND_COUNT + 2;
+		Check(cluster.m_iHistogramBin == bin, string.Format("Cluster %1 binned at %2, expected %3", where, cluster.m_iHistogramBin, bin));
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_TelemetryTest : VSC_TestCase
+{
+	static const int TICKS = 40;
+	static const int WINDOWS = 20;
+
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		// One interval of a client: sources and an explosion
+		m_Scenario.AddSources(6, 5.0, 40.0);
+		m_Scenario.Start();
+		VSC_TelemetrySampler sampler = new VSC_TelemetrySampler();
+		sampler.Begin(m_Scenario.m_Stats, m_Scenario.m_Pipeline.GetClock().GetMs());
+		for (int i = 0; i < TICKS; i++)
+		{
+			if (i == 10)
+				m_Scenario.Explode("5 0 5");
+
+			m_Scenario.Step();
+			sampler.Sample(m_Scenario.m_Pipeline, m_Scenario.m_Stats);
+		}
+
+		VSC_TelemetryReport report = sampler.TakeReport(m_Scenario.m_Stats, m_Scenario.m_Pipeline.GetClock().GetMs());
+		Check(report.m_iTicks == TICKS && report.m_iIntervalMs == TICKS * VSC_TestScenario.TICK_MS, string.Format("Report covers %1 ticks in %2 ms", report.m_iTicks, report.m_iIntervalMs));
+		Check(report.m_iDampenings == 1, string.Format("Report counts %1 dampenings, expected 1", report.m_iDampenings));
+		Check(report.m_iPerceptionWrites > 0, "Report counts no perception writes");
+		Check(report.m_iTrackedMax == 6 && report.m_iTrackedSum > 0, string.Format("Report saw at most %1 tracked sources", report.m_iTrackedMax));
+		Check(report.m_WindowCost.GetWindowCount(EVSC_Stage.TRACKING) == 1, string.Format("%1 ticks closed %2 cost windows, expected 1", TICKS, report.m_WindowCost.GetWindowCount(EVSC_Stage.TRACKING)));
+
+		// Known run times: tracking costs 2 ms once per second of ticks, 40 ms in one second
+		VSC_StageStats stats = new VSC_StageStats();
+		sampler.OnStatsReset();
+		int ticksPerWindow = VSC_WindowCostHistogram.WINDOW_MS / VSC_TestScenario.TICK_MS;
+		for (int window = 0; window <= WINDOWS; window++)
+		{
+			for (int tick = 0; tick < ticksPerWindow; tick++)
+			{
+				int elapsedMs = 0;
+				if (tick == ticksPerWindow / 2)
+					elapsedMs = 2;
+
+				if (tick == ticksPerWindow / 2 && window == WINDOWS - 1)
+					elapsedMs = 40;
+
+				stats.Record(EVSC_Stage.TRACKING, elapsedMs);
+				m_Scenario.Step();
+				sampler.Sample(m_Scenario.m_Pipeline, stats);
+			}
+		}
+
+		VSC_TelemetryReport windowed = sampler.TakeReport(stats, m_Scenario.m_Pipeline.GetClock().GetMs());
+		VSC_WindowCostHistogram windowCost = windowed.m_WindowCost;
+		Check(windowCost.GetWindowCount(EVSC_Stage.TRACKING) == WINDOWS, string.Format("%1 cost windows, expected %2", windowCost.GetWindowCount(EVSC_Stage.TRACKING), WINDOWS));
+		Check(windowCost.GetPercentileMs(EVSC_Stage.TRACKING, 0.5) == 2 && windowCost.GetPercentileMs(EVSC_Stage.TRACKING, 0.95) == 2, "Window percentiles do not follow the recorded runs");
+		Check(windowCost.GetPercentileMs(EVSC_Stage.TRACKING, 0.99) == 40, "Costly second missing from p99");
+		Check(windowed.m_Stats.GetCalls(EVSC_Stage.TRACKING) == (WINDOWS + 1) * ticksPerWindow, "Runs before the stats reset counted");
+
+		// The next interval starts empty
+		stats.Record(EVSC_Stage.TRACKING, 1);
+		VSC_TelemetryReport next = sampler.TakeReport(stats, m_Scenario.m_Pipeline.GetClock().GetMs());
+		Check(next.m_iTicks == 0 && next.m_iDampenings == 0 && next.m_Stats.GetCalls(EVSC_Stage.TRACKING) == 1, "Second interval repeats the first");
+		Check(next.m_WindowCost.GetWindowCount(EVSC_Stage.TRACKING) == 0, "Second interval repeats the first's cost windows");
+
+		// The wire format carries everything, malformed packets are refused
+		VSC_TelemetryReport decoded = new VSC_TelemetryReport();
+		Check(decoded.Decode(windowed.Encode()), "Encoded report does not decode");
+		Check(decoded.Encode() == windowed.Encode(), "Report changed on the way through the wire format");
+		VSC_TelemetryReport malformed = new VSC_TelemetryReport();
+		Check(!malformed.Decode("2,2,3"), "Truncated report accepted");
+		Check(!malformed.Decode(windowed.Encode() + ",0 0"), "Report with an extra stage accepted");
+
+		// Two clients merge into one distribution, a client reporting too often is dropped
+		VSC_TelemetryAggregator aggregator = new VSC_TelemetryAggregator();
+		Check(aggregator.Add(1, windowed, 0.0) && aggregator.Add(2, decoded, 0.0), "Reports from two players not merged");
+		Check(!aggregator.Add(1, windowed, 1000.0), "Report one second after the last one accepted");
+		Check(aggregator.GetReportCount() == 2 && aggregator.GetStageStats().GetCalls(EVSC_Stage.TRACKING) == 2 * windowed.m_Stats.GetCalls(EVSC_Stage.TRACKING), "Merged stage runs do not add up");
+		VSC_WindowCostHistogram merged = aggregator.GetWindowCost();
+		Check(merged.GetWindowCount(EVSC_Stage.TRACKING) == WINDOWS * 2 && merged.GetPercentileMs(EVSC_Stage.TRACKING, 0.95) == 2 && merged.GetPercentileMs(EVSC_Stage.TRACKING, 0.99) == 40, "Merged window percentiles differ from the clients'");
+
+		string json = aggregator.ToJson();
+		Check(json.Contains("\"players\": 2") && json.Contains("\"TRACKING\"") && json.Contains("\"p99MsPerSecond\": 40"), "Session JSON is missing the merged counts");
+
+		m_Scenario.m_Pipeline.Deactivate();
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Tracking and filtering at a fixed source count, with stage budgets
+//------------------------------------------------------------------------------------------------
+class VSC_ScaleTestBase : VSC_TestCase
+{
+	//------------------------------------------------------------------------------------------------
+	protected void RunScale(int sourceCount)
+	{
+		m_Scenario.AddSources(sourceCount);
+		m_Scenario.Start();
+		m_Scenario.m_Stats.Reset();
+		m_Scenario.Step(VSC_TestBudgets.BENCH_TICKS);
+
+		VSC_BOSSAProcessor bossa = m_Scenario.m_Pipeline.GetBOSSA();
+		int tracked = bossa.GetTrackedSourceCount();
+		Check(tracked > 0, string.Format("No sources tracked out of %1", sourceCount));
+		Check(tracked <= m_Scenario.m_BOSSAProfile.m_iMaxTrackedSources, string.Format("Tracked %1 sources, cap is %2", tracked, m_Scenario.m_BOSSAProfile.m_iMaxTrackedSources));
+
+		float gain = m_Scenario.m_Pipeline.GetGain();
+		Check(gain > 0.0 && gain < 100.0, string.Format("Implausible gain %1", gain));
+
+		CheckBudget(EVSC_Stage.PROTECTION, VSC_TestBudgets.PROTECTION_US);
+		CheckBudget(EVSC_Stage.TRACKING, VSC_TestBudgets.GetTrackingBudget(sourceCount));
+		CheckBudget(EVSC_Stage.FILTERING, VSC_TestBudgets.FILTERING_US);
+
+		m_Scenario.m_Pipeline.Deactivate();
+		Finish();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_Scale10Test : VSC_ScaleTestBase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		RunScale(10);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_Scale64Test : VSC_ScaleTestBase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		RunScale(64);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+[Test("VSC_TestSuite")]
+class VSC_Scale256Test : VSC_ScaleTestBase
+{
+	//------------------------------------------------------------------------------------------------
+	[Step(EStage.Main)]
+	void Run()
+	{
+		RunScale(256);
+	}
+}
@@ -0,0 +1,393 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - AI Hearing System
+// Server-side batch mode applying the hearing protection model (boost, explosion dampening) to
+// every AI character wearing qualifying headgear. State lives in one structure-of-arrays table,
+// updated round-robin under a per-frame budget from a single callqueue entry. Changes that must
+// not wait for the round-robin - a new row's boost, an explosion, a dampening running out - are
+// written straight away.
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+class VSC_AIHearingSystem
+{
+	protected static ref VSC_AIHearingSystem s_Instance;
+
+	// Full rescan of the AI population, spread over frames like the update
+	private const int DISCOVERY_INTERVAL_MS = 5000;
+	private const int DISCOVERY_AGENTS_PER_FRAME = 32;
+
+	private bool m_bAutoAttach;
+	private int m_iUpdatesPerFrame;
+
+	// One row per registered AI character
+	protected ref array<string> m_aIds = {};
+	protected ref array<ChimeraCharacter> m_aCharacters = {};
+	protected ref array<PerceptionComponent> m_aPerception = {};
+	protected ref array<VSC_ProtectionProfile> m_aProfiles = {};
+	protected ref array<float> m_aOriginalRange = {};
+	protected ref array<float> m_aAppliedRange = {};
+	protected ref array<float> m_aDampenEndTime = {};
+	protected ref map<string, int> m_mRowById = new map<string, int>();
+	private int m_iUpdateCursor;
+	private float m_fNextReleaseTime = float.MAX; // Earliest dampening end not yet written, float.MAX when none
+
+	// Discovery snapshot, consumed DISCOVERY_AGENTS_PER_FRAME at a time
+	private ref array<AIAgent> m_aAgents = {};
+	private int m_iDiscoveryCursor;
+	private float m_fNextDiscoveryTime;
+
+	//------------------------------------------------------------------------------------------------
+	// Create the server singleton (no-op on clients connected to a server)
+	//------------------------------------------------------------------------------------------------
+	static VSC_AIHearingSystem Create(bool autoAttach, int updatesPerFrame)
+	{
+		if (RplSession.Mode() == RplMode.Client)
+			return null;
+
+		if (!s_Instance)
+		{
+			s_Instance = new VSC_AIHearingSystem();
+			s_Instance.Start(autoAttach, updatesPerFrame);
+		}
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static VSC_AIHearingSystem GetInstance()
+	{
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static void Destroy()
+	{
+		if (!s_Instance)
+			return;
+
+		s_Instance.Stop();
+		s_Instance = null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Start(bool autoAttach, int updatesPerFrame)
+	{
+		m_bAutoAttach = autoAttach;
+		m_iUpdatesPerFrame = Math.Max(updatesPerFrame, 1);
+
+		BaseWorld world = GetGame().GetWorld();
+		if (world)
+			world.GetOnExplosion().Insert(OnExplosion);
+
+		// Single entry for the whole population, runs every frame
+		GetGame().GetCallqueue(CALL_CATEGORY_GAMEPLAY).CallLater(Update, 0, true);
+
+#ifndef VSC_NO_LOGGING
+		Print("[VSC AI] AI hearing system started, budget " + m_iUpdatesPerFrame + " characters per frame", LogLevel.NORMAL);
+#endif
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Stop()
+	{
+		GetGame().GetCallqueue(CALL_CATEGORY_GAMEPLAY).Remove(Update);
+
+		BaseWorld world = GetGame().GetWorld();
+		if (world)
+			world.GetOnExplosion().Remove(OnExplosion);
+
+		// Restore every AI's hearing to its original state
+		for (int i = m_aIds.Count() - 1; i >= 0; i--)
+		{
+			RemoveRow(i);
+		}
+
+		m_aAgents.Clear();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetCount()
+	{
+		return m_aIds.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Auditory range last written for an AI, -1 if it is not registered
+	//------------------------------------------------------------------------------------------------
+	float GetAppliedRange(string id)
+	{
+		int row;
+		if (!m_mRowById.Find(id, row))
+			return -1.0;
+
+		return m_aAppliedRange[row];
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Per-frame work: one discovery slice, then the table
+	//------------------------------------------------------------------------------------------------
+	protected void Update()
+	{
+		float currentTime = VSC_Clock.SampleWorld().GetMs();
+		DiscoverSlice(currentTime);
+		UpdateTable(currentTime);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Dampenings that ran out are released first, then up to m_iUpdatesPerFrame rows round-robin
+	//------------------------------------------------------------------------------------------------
+	protected void UpdateTable(float currentTime)
+	{
+		if (currentTime >= m_fNextReleaseTime)
+			ReleaseExpired(currentTime);
+
+		int count = m_aIds.Count();
+		int budget = Math.Min(m_iUpdatesPerFrame, count);
+		for (int n = 0; n < budget; n++)
+		{
+			if (m_aIds.IsEmpty())
+				break;
+
+			if (m_iUpdateCursor >= m_aIds.Count())
+				m_iUpdateCursor = 0;
+
+			// Deleted characters are dropped, the swapped-in row is processed next
+			if (!IsRowAlive(m_iUpdateCursor))
+			{
+				RemoveRow(m_iUpdateCursor);
+				continue;
+			}
+
+			UpdateRow(m_iUpdateCursor, currentTime);
+			m_iUpdateCursor++;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Apply the boost or dampening of one row, writing the perception only on change
+	//------------------------------------------------------------------------------------------------
+	protected void UpdateRow(int row, float currentTime)
+	{
+		VSC_ProtectionProfile profile = m_aProfiles[row];
+
+		float gain = profile.m_fBoostMultiplier;
+		if (currentTime < m_aDampenEndTime[row])
+			gain = profile.m_fDampenMultiplier;
+
+		float range = m_aOriginalRange[row] * gain;
+		if (range == m_aAppliedRange[row])
+			return;
+
+		WriteRange(row, range);
+		m_aAppliedRange[row] = range;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Restore the boost of every row whose dampening has ended, without waiting for the
+	// round-robin (runs only when the earliest pending end has passed)
+	//------------------------------------------------------------------------------------------------
+	protected void ReleaseExpired(float currentTime)
+	{
+		m_fNextReleaseTime = float.MAX;
+		for (int i = 0; i < m_aIds.Count(); i++)
+		{
+			float endTime = m_aDampenEndTime[i];
+			if (endTime > currentTime)
+				m_fNextReleaseTime = Math.Min(m_fNextReleaseTime, endTime);
+			else if (IsRowAlive(i))
+				UpdateRow(i, currentTime); // Writes only the rows still dampened
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool IsRowAlive(int row)
+	{
+		return m_aCharacters[row] && m_aPerception[row];
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected vector GetRowOrigin(int row)
+	{
+		return m_aCharacters[row].GetOrigin();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void WriteRange(int row, float range)
+	{
+		if (m_aPerception[row])
+			m_aPerception[row].SetAuditoryRange(range);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Register or drop a slice of AI agents, refreshing the snapshot every DISCOVERY_INTERVAL_MS
+	//------------------------------------------------------------------------------------------------
+	protected void DiscoverSlice(float currentTime)
+	{
+		if (m_iDiscoveryCursor >= m_aAgents.Count())
+		{
+			if (currentTime < m_fNextDiscoveryTime)
+				return;
+
+			m_fNextDiscoveryTime = currentTime + DISCOVERY_INTERVAL_MS;
+			m_iDiscoveryCursor = 0;
+			m_aAgents.Clear();
+
+			AIWorld aiWorld = GetGame().GetAIWorld();
+			if (aiWorld)
+				aiWorld.GetAIAgents(m_aAgents);
+		}
+
+		int end = Math.Min(m_iDiscoveryCursor + DISCOVERY_AGENTS_PER_FRAME, m_aAgents.Count());
+		for (int i = m_iDiscoveryCursor; i < end; i++)
+		{
+			AIAgent agent = m_aAgents[i];
+			if (agent)
+				Discover(ChimeraCharacter.Cast(agent.GetControlledEntity()), currentTime);
+		}
+
+		m_iDiscoveryCursor = end;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Track an AI character while it wears qualifying headgear (groups are not characters)
+	//------------------------------------------------------------------------------------------------
+	protected void Discover(ChimeraCharacter character, float currentTime)
+	{
+		if (!character)
+			return;
+
+		string id = character.GetID().ToString();
+		int row;
+		bool registered = m_mRowById.Find(id, row);
+
+		// Possessed characters are handled by the owning client's local controller
+		IEntity headgear;
+		if (GetGame().GetPlayerManager().GetPlayerIdFromControlledEntity(character) == 0)
+			headgear = VSC_Headgear.FindQualifyingHeadgear(character, m_bAutoAttach);
+
+		if (!headgear)
+		{
+			if (registered)
+				RemoveRow(row);
+
+			return;
+		}
+
+		VSC_ProtectionProfile profile = VSC_Headgear.GetProtectionProfile(headgear);
+		if (!profile)
+		{
+			if (!m_bAutoAttach)
+			{
+				// BOSSA-only headgear - AI get no spatial filtering
+				if (registered)
+					RemoveRow(row);
+
+				return;
+			}
+
+			profile = VSC_ProfileRegistry.GetProtectionProfile(string.Empty);
+		}
+
+		if (registered)
+		{
+			// Headgear swapped, keep timers and apply the new profile at once
+			m_aProfiles[row] = profile;
+			UpdateRow(row, currentTime);
+			return;
+		}
+
+		PerceptionComponent perception = PerceptionComponent.Cast(character.FindComponent(PerceptionComponent));
+		if (!perception)
+			return;
+
+		InsertRow(id, character, perception, profile, perception.GetAuditoryRange(), currentTime);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Add a row and apply its boost at once
+	//------------------------------------------------------------------------------------------------
+	protected void InsertRow(string id, ChimeraCharacter character, PerceptionComponent perception, VSC_ProtectionProfile profile, float originalRange, float currentTime)
+	{
+		int row = m_aIds.Count();
+		m_mRowById.Insert(id, row);
+		m_aIds.Insert(id);
+		m_aCharacters.Insert(character);
+		m_aPerception.Insert(perception);
+		m_aProfiles.Insert(profile);
+		m_aOriginalRange.Insert(originalRange);
+		m_aAppliedRange.Insert(originalRange);
+		m_aDampenEndTime.Insert(0);
+
+		UpdateRow(row, currentTime);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Restore the row's hearing and swap-remove it from the table
+	//------------------------------------------------------------------------------------------------
+	protected void RemoveRow(int row)
+	{
+		if (m_aAppliedRange[row] != m_aOriginalRange[row])
+			WriteRange(row, m_aOriginalRange[row]);
+
+		m_mRowById.Remove(m_aIds[row]);
+
+		int last = m_aIds.Count() - 1;
+		if (row != last)
+			m_mRowById.Set(m_aIds[last], row);
+
+		// array.Remove moves the last element into the removed slot
+		m_aIds.Remove(row);
+		m_aCharacters.Remove(row);
+		m_aPerception.Remove(row);
+		m_aProfiles.Remove(row);
+		m_aOriginalRange.Remove(row);
+		m_aAppliedRange.Remove(row);
+		m_aDampenEndTime.Remove(row);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Dampen every registered AI within its profile's trigger range, written immediately
+	//------------------------------------------------------------------------------------------------
+	protected void OnExplosion(IEntity explosionEntity, IEntity source, vector position, float rawDamage, float range, EExplosionType type)
+	{
+		if (!m_aIds.IsEmpty())
+			DampenAround(position, VSC_Clock.SampleWorld().GetMs());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void DampenAround(vector position, float currentTime)
+	{
+		for (int i = 0; i < m_aIds.Count(); i++)
+		{
+			if (!IsRowAlive(i))
+				continue;
+
+			VSC_ProtectionProfile profile = m_aProfiles[i];
+			float triggerRange = profile.m_fDampenTriggerRange;
+			if (vector.DistanceSq(GetRowOrigin(i), position) > triggerRange * triggerRange)
+				continue;
+
+			ApplyDampening(i, currentTime, profile.m_iDampenDurationMs);
+			UpdateRow(i, currentTime);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Same extend/cooldown rules as VSC_ProtectionProcessor.ApplyDampening: a loud event always
+	// starts or extends a dampening, which releases no sooner than the cooldown after it started
+	//------------------------------------------------------------------------------------------------
+	protected void ApplyDampening(int row, float currentTime, int durationMs)
+	{
+		// Overlapping loud events extend an active dampening, never shorten it
+		if (currentTime < m_aDampenEndTime[row])
+		{
+			m_aDampenEndTime[row] = Math.Max(m_aDampenEndTime[row], currentTime + durationMs);
+			return;
+		}
+
+		// Profile cooldown is in seconds
+		float cooldownMs = VSC_Clock.SecondsToMs(m_aProfiles[row].m_fDampeningCooldown);
+		m_aDampenEndTime[row] = currentTime + Math.Max(durationMs, cooldownMs);
+		m_fNextReleaseTime = Math.Min(m_fNextReleaseTime, m_aDampenEndTime[row]);
+	}
+}
@@ -0,0 +1,211 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Acoustic Grid
+// Lazily baked, memory-bounded cache of per-cell acoustic properties around the listener.
+// A cell is probed once, the first time a listener enters it, and looked up with a single map
+// access afterwards. The least recently used cell is evicted when the cache is full.
+// The base grid bakes every cell as open terrain (replays and tests).
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------------------------
+// Acoustic properties of the listener's surroundings (defaults = open terrain)
+//------------------------------------------------------------------------------------------------
+class VSC_Acoustics
+{
+	float m_fEnclosure = 0.0; // 0 = open sky, 1 = roofed and walled in (building, vehicle)
+	float m_fOpenness = 1.0; // Mean free distance around the listener, relative to the probe range
+	float m_fHardSurfaces = 0.0; // Share of directions with a reflecting surface close by
+
+	//------------------------------------------------------------------------------------------------
+	void Set(float enclosure, float openness, float hardSurfaces)
+	{
+		m_fEnclosure = enclosure;
+		m_fOpenness = openness;
+		m_fHardSurfaces = hardSurfaces;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+class VSC_AcousticCell : VSC_Acoustics
+{
+	int m_iKey;
+	int m_iLastUsed; // Lookup stamp for LRU eviction
+}
+
+//------------------------------------------------------------------------------------------------
+class VSC_AcousticGrid
+{
+	static const float CELL_SIZE = 8.0; // Meters, horizontal only - one bake covers all floors of a cell
+	static const int DEFAULT_CAPACITY = 256;
+
+	protected int m_iCapacity;
+	protected ref map<int, ref VSC_AcousticCell> m_mCells = new map<int, ref VSC_AcousticCell>();
+	protected int m_iLookupCount;
+	protected int m_iBakeCount;
+
+	//------------------------------------------------------------------------------------------------
+	void VSC_AcousticGrid(int capacity = DEFAULT_CAPACITY)
+	{
+		m_iCapacity = Math.Max(capacity, 1);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Acoustics of the cell containing position, baking it on first use
+	//------------------------------------------------------------------------------------------------
+	VSC_AcousticCell Lookup(vector position)
+	{
+		int key = GetKey(position);
+		m_iLookupCount++;
+
+		VSC_AcousticCell cell;
+		if (m_mCells.Find(key, cell))
+		{
+			cell.m_iLastUsed = m_iLookupCount;
+			return cell;
+		}
+
+		// Rare (once per entered cell) - a linear scan for the oldest cell is fine here
+		if (m_mCells.Count() >= m_iCapacity)
+			EvictLeastRecentlyUsed();
+
+		cell = new VSC_AcousticCell();
+		cell.m_iKey = key;
+		cell.m_iLastUsed = m_iLookupCount;
+		Bake(cell, position);
+		m_iBakeCount++;
+
+		m_mCells.Insert(key, cell);
+		return cell;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Clear()
+	{
+		m_mCells.Clear();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetCount()
+	{
+		return m_mCells.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetBakeCount()
+	{
+		return m_iBakeCount;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Cell coordinates packed into 16 bits each (maps up to 524 km across)
+	//------------------------------------------------------------------------------------------------
+	static int GetKey(vector position)
+	{
+		int cellX = Math.Floor(position[0] / CELL_SIZE);
+		int cellZ = Math.Floor(position[2] / CELL_SIZE);
+		return ((cellX & 0xFFFF) << 16) | (cellZ & 0xFFFF);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Compute a cell's properties from the position the listener entered it at
+	//------------------------------------------------------------------------------------------------
+	protected void Bake(VSC_AcousticCell cell, vector position)
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void EvictLeastRecentlyUsed()
+	{
+		int oldestKey;
+		int oldestUse = int.MAX;
+		for (int i = 0; i < m_mCells.Count(); i++)
+		{
+			VSC_AcousticCell cell = m_mCells.GetElement(i);
+			if (cell.m_iLastUsed < oldestUse)
+			{
+				oldestUse = cell.m_iLastUsed;
+				oldestKey = cell.m_iKey;
+			}
+		}
+
+		m_mCells.Remove(oldestKey);
+	}
+}
+
+#ifndef VSC_SERVER_LITE
+//------------------------------------------------------------------------------------------------
+// Bakes cells with a ring of horizontal traces plus one upwards at head height, against static
+// geometry only
+//------------------------------------------------------------------------------------------------
+class VSC_WorldAcousticGrid : VSC_AcousticGrid
+{
+	private const int PROBE_DIRECTIONS = 8;
+	private const float PROBE_RANGE = 20.0;
+	private const float CEILING_RANGE = 15.0;
+	private const float HARD_SURFACE_RANGE = 5.0; // Walls this close give strong early reflections
+	private const float HEAD_HEIGHT = 1.6;
+
+	//------------------------------------------------------------------------------------------------
+	override protected void Bake(VSC_AcousticCell cell, vector position)
+	{
+		BaseWorld world = GetGame().GetWorld();
+		if (!world)
+			return;
+
+		vector head = position + Vector(0, HEAD_HEIGHT, 0);
+		float freeDistance = 0.0;
+		int walls = 0;
+		int hardSurfaces = 0;
+
+		for (int i = 0; i < PROBE_DIRECTIONS; i++)
+		{
+			float angle = Math.PI2 * i / PROBE_DIRECTIONS;
+			vector direction = Vector(Math.Sin(angle), 0, Math.Cos(angle));
+			float distance = Probe(world, head, direction * PROBE_RANGE) * PROBE_RANGE;
+
+			freeDistance += distance;
+			if (distance < PROBE_RANGE)
+				walls++;
+
+			if (distance < HARD_SURFACE_RANGE)
+				hardSurfaces++;
+		}
+
+		bool roofed = Probe(world, head, Vector(0, CEILING_RANGE, 0)) < 1.0;
+
+		// Walls alone make a courtyard at most half enclosed, a roof makes the rest
+		float directions = PROBE_DIRECTIONS;
+		float enclosure = 0.5 * walls / directions;
+		if (roofed)
+			enclosure += 0.5;
+
+		cell.Set(enclosure, freeDistance / (directions * PROBE_RANGE), hardSurfaces / directions);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Free fraction of the segment start -> start + offset
+	//------------------------------------------------------------------------------------------------
+	protected float Probe(BaseWorld world, vector start, vector offset)
+	{
+		TraceParam param = new TraceParam();
+		param.Start = start;
+		param.End = start + offset;
+		param.Flags = TraceFlags.WORLD | TraceFlags.ENTS;
+		return world.TraceMove(param, IsStaticGeometry);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Trace filter: a cell is baked once, so characters (the listener included), vehicles, their
+	// equipment and loose physics objects passing through must not be baked into it
+	//------------------------------------------------------------------------------------------------
+	protected bool IsStaticGeometry(notnull IEntity entity, vector start = "0 0 0", vector dir = "0 0 0")
+	{
+		IEntity root = entity.GetRootParent();
+		if (ChimeraCharacter.Cast(root) || Vehicle.Cast(root))
+			return false;
+
+		Physics physics = entity.GetPhysics();
+		return !physics || !physics.IsDynamic();
+	}
+}
+#endif
@@ -0,0 +1,147 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Audio Output
+// Applies the compressor gain to what the player actually hears. Attenuation is written in the
+// same frame it is requested (an explosion or gunshot is never heard unprotected); the release
+// back to the user's level is smoothed once per frame. Gains above 1 are capped - the mix is
+// never raised over the user's own volume, boost only affects the auditory range.
+// The base class only tracks the volume (replays and tests).
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+class VSC_AudioOutput
+{
+	static const float RELEASE_MS = 150.0; // Time constant of the return to the user's level
+	static const float MIN_CHANGE = 0.005; // Smaller volume steps are not written
+
+	protected float m_fBaseVolume = -1.0; // User's volume captured on Begin, -1 while not begun
+	protected float m_fTargetGain = 1.0;
+	protected float m_fGain = 1.0;
+	protected float m_fAppliedVolume = -1.0;
+	protected float m_fLastUpdateTime = -1.0;
+	protected int m_iWriteCount = 0;
+
+	//------------------------------------------------------------------------------------------------
+	void Begin()
+	{
+		m_fBaseVolume = ReadVolume();
+		m_fTargetGain = 1.0;
+		m_fGain = 1.0;
+		m_fAppliedVolume = m_fBaseVolume;
+		m_fLastUpdateTime = -1.0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// New compressor gain - attenuation is applied immediately, release waits for Update
+	//------------------------------------------------------------------------------------------------
+	void SetTarget(float gain)
+	{
+		if (m_fBaseVolume < 0.0)
+			return;
+
+		m_fTargetGain = Math.Clamp(gain, 0.0, 1.0);
+		if (m_fTargetGain < m_fGain)
+		{
+			m_fGain = m_fTargetGain;
+			ApplyVolume();
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Once per frame: move towards the target, writing only on a noticeable change
+	//------------------------------------------------------------------------------------------------
+	void Update(float currentTime)
+	{
+		if (m_fBaseVolume < 0.0)
+			return;
+
+		float deltaMs = 0.0;
+		if (m_fLastUpdateTime >= 0.0)
+			deltaMs = currentTime - m_fLastUpdateTime;
+
+		m_fLastUpdateTime = currentTime;
+
+		if (m_fGain == m_fTargetGain || deltaMs <= 0.0)
+			return;
+
+		m_fGain += (m_fTargetGain - m_fGain) * deltaMs / (deltaMs + RELEASE_MS);
+		if (Math.AbsFloat(m_fTargetGain - m_fGain) * m_fBaseVolume <= MIN_CHANGE)
+			m_fGain = m_fTargetGain;
+
+		ApplyVolume();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Put the user's volume back (deactivation, detach, suspension)
+	//------------------------------------------------------------------------------------------------
+	void Restore()
+	{
+		if (m_fBaseVolume < 0.0)
+			return;
+
+		if (m_fAppliedVolume != m_fBaseVolume)
+			Write(m_fBaseVolume);
+
+		m_fBaseVolume = -1.0;
+		m_fAppliedVolume = -1.0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	float GetAppliedVolume()
+	{
+		return m_fAppliedVolume;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetWriteCount()
+	{
+		return m_iWriteCount;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void ApplyVolume()
+	{
+		float volume = m_fBaseVolume * m_fGain;
+		if (volume == m_fAppliedVolume)
+			return;
+
+		// Inaudible intermediate release steps are skipped, the target is always written
+		if (m_fGain != m_fTargetGain && Math.AbsFloat(volume - m_fAppliedVolume) <= MIN_CHANGE)
+			return;
+
+		Write(volume);
+		m_fAppliedVolume = volume;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected float ReadVolume()
+	{
+		return 1.0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Write(float volume)
+	{
+		m_iWriteCount++;
+	}
+}
+
+#ifndef VSC_SERVER_LITE
+//------------------------------------------------------------------------------------------------
+// Scales the client's sound-effects master volume (weapons, explosions, footsteps, vehicles)
+//------------------------------------------------------------------------------------------------
+class VSC_MasterVolumeOutput : VSC_AudioOutput
+{
+	//------------------------------------------------------------------------------------------------
+	override protected float ReadVolume()
+	{
+		return AudioSystem.GetMasterVolume(AudioSystem.SFX);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override protected void Write(float volume)
+	{
+		super.Write(volume);
+		AudioSystem.SetMasterVolume(AudioSystem.SFX, volume);
+	}
+}
+#endif
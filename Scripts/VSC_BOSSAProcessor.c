@@ -0,0 +1,976 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - BOSSA Processor
+// Spatial tracking, inhibitory filtering and selective attention for the listener of its input
+// provider. Owned and ticked by VSC_LocalController (or a replay), tuned by a VSC_BOSSAProfile.
+// Author: jcrashkit
+// Based on research by Kamal Sen, Alexander D. Boyd, and Virginia Best at Boston University
+//------------------------------------------------------------------------------------------------
+
+class VSC_BOSSAProcessor
+{
+	private VSC_InputProvider m_Input;
+	private VSC_Clock m_Clock;
+	private ref VSC_BOSSAProfile m_Profile;
+	private VSC_StageStats m_Stats;
+	private float m_fOriginalAuditoryRange;
+	private bool m_bIsActive = false;
+
+	// Spatial sound tracking
+	private ref array<ref VSC_TrackedSoundSource> m_aTrackedSources;
+	private ref map<string, VSC_TrackedSoundSource> m_mTrackedById = new map<string, VSC_TrackedSoundSource>();
+	private ref array<ref VSC_SourceSample> m_aQueryResults = {};
+
+	// Per-source refresh scheduling: near, fast sources every tick, far, static ones about once a second
+	private ref VSC_RefreshQueue m_RefreshQueue = new VSC_RefreshQueue();
+	// Top-K selection: the weakest tracked source is evicted when a stronger candidate appears
+	private ref VSC_ImportanceHeap m_ImportanceHeap = new VSC_ImportanceHeap();
+	// Azimuth x distance histogram, kept up to date on every refresh and read by the filter kernels
+	private ref VSC_SectorHistogram m_Histogram = new VSC_SectorHistogram();
+	// Discovery sweeps the search sphere a few regions per tick instead of one large query
+	private ref VSC_DiscoverySweep m_Sweep = new VSC_DiscoverySweep();
+	private const int SWEEP_REGIONS_PER_TICK = 2; // 19 regions, a full sweep every 10 ticks (500 ms)
+	private const float MIN_REFRESH_INTERVAL_MS = 50.0;
+	private const float MAX_REFRESH_INTERVAL_MS = 1000.0;
+	private const float REFRESH_TOLERANCE = 0.1; // Metres of relative movement tolerated between refreshes...
+	private const float REFRESH_TOLERANCE_PER_METER = 0.05; // ...growing with distance
+	private const float ATTENTION_CONE_IMPORTANCE = 1.5;
+
+	// Distant candidates that miss the top-K are clustered by grid cell instead of dropped, each
+	// cluster binned as one virtual source at its centroid
+	private ref VSC_SourceClusters m_Clusters = new VSC_SourceClusters();
+	private const float CLUSTER_DISTANCE = 50.0; // Far band of the sector histogram, nearer sources stay individual
+	private const float CLUSTER_EXPIRY_MS = 1000.0; // Members not found again by the sweep for this long (two sweeps) leave
+	private const int CLUSTER_EXPIRY_CHECKS = 32; // Members checked for expiry per tick
+
+	// Temporal coherence: persistence builds over this many temporal windows and adds rank weight
+	private const float PERSISTENCE_WINDOWS = 10.0;
+	private const float PERSISTENCE_IMPORTANCE = 0.5;
+	private int m_iRefreshCount = 0;
+
+	// Performance optimization - cached values
+	private vector m_vCachedPlayerDir;
+	private float m_fLastDirUpdateTime = 0.0;
+	private const float DIRECTION_REFRESH_MS = 100.0;
+	private int m_iUpdateCounter = 0; // Paces adaptive learning
+	private const int STAGGERED_UPDATE_INTERVAL = 3; // Adaptive learning every Nth frame
+	private const int RETARGET_BURST_TICKS = 5; // Full sweep and refresh every tick this long after Retarget
+	private int m_iBurstTicks = 0;
+
+	// Reverberant surroundings smear direction - off-axis sources are suppressed harder
+	private const float REVERB_SUPPRESSION = 0.5;
+	private float m_fReverberation = 0.0;
+
+	// Filter output, read by the controller as an auditory range multiplier
+	private float m_fSpatialGain = 1.0;
+	private float m_fAttentionGain = 1.0;
+
+	// Adaptive learning state
+	private float m_fLearnedAttentionAngle = 45.0;
+	private float m_fLearnedEnhancementLevel = 1.0;
+	private VSC_LearnedState m_LearnedState; // Optional, carries learning across activations
+
+	//------------------------------------------------------------------------------------------------
+	void VSC_BOSSAProcessor(VSC_InputProvider input, VSC_Clock clock, VSC_BOSSAProfile profile)
+	{
+		m_Input = input;
+		m_Clock = clock;
+		m_Profile = profile;
+		m_aTrackedSources = new array<ref VSC_TrackedSoundSource>();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Optional stage timing (benchmarks and replays)
+	//------------------------------------------------------------------------------------------------
+	void SetStageStats(VSC_StageStats stats)
+	{
+		m_Stats = stats;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Learning state to start from and keep updated (set before Activate)
+	//------------------------------------------------------------------------------------------------
+	void SetLearnedState(VSC_LearnedState state)
+	{
+		m_LearnedState = state;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Swap the tuning in place (runtime tuning), keeping tracked sources and learned state. Sources
+	// over a lowered cap are evicted weakest first, the rest are re-scored on the next tick.
+	//------------------------------------------------------------------------------------------------
+	void SetProfile(VSC_BOSSAProfile profile)
+	{
+		m_Profile = profile;
+
+		while (m_aTrackedSources.Count() > m_Profile.m_iMaxTrackedSources)
+		{
+			VSC_TrackedSoundSource weakest = m_ImportanceHeap.Peek();
+			if (!weakest)
+				break;
+
+			RemoveTrackedSource(weakest);
+		}
+
+		if (!m_bIsActive)
+			return;
+
+		float currentTime = m_Clock.GetMs();
+		foreach (VSC_TrackedSoundSource source : m_aTrackedSources)
+		{
+			m_RefreshQueue.Schedule(source, currentTime);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Start processing for the input's listener
+	//------------------------------------------------------------------------------------------------
+	void Activate(float originalAuditoryRange)
+	{
+		m_fOriginalAuditoryRange = originalAuditoryRange;
+		ClearTrackedSources();
+		m_iRefreshCount = 0;
+		m_iUpdateCounter = 0;
+		m_iBurstTicks = 0;
+		m_Sweep.Restart();
+		m_fLastDirUpdateTime = 0.0;
+		m_vCachedPlayerDir = m_Input.GetListenerForward();
+		m_fSpatialGain = 1.0;
+		m_fAttentionGain = 1.0;
+
+		// Initialize learned parameters (warm start from earlier lives when available)
+		m_fLearnedAttentionAngle = m_Profile.m_fAttentionConeAngle;
+		m_fLearnedEnhancementLevel = m_Profile.m_fFrontEnhancementMultiplier;
+#ifndef VSC_NO_ADAPTIVE_LEARNING
+		if (m_Profile.m_bAdaptiveLearning && m_LearnedState && m_LearnedState.m_bValid)
+		{
+			m_fLearnedAttentionAngle = m_LearnedState.m_fAttentionAngle;
+			m_fLearnedEnhancementLevel = m_LearnedState.m_fEnhancementLevel;
+		}
+#endif
+
+		m_bIsActive = true;
+
+#ifndef VSC_NO_LOGGING
+		Print("[VSC BOSSA] Biologically Oriented Sound Segregation Algorithm initialized", LogLevel.NORMAL);
+		Print("[VSC BOSSA] Spatial filtering active - Attention cone: " + m_Profile.m_fAttentionConeAngle + " degrees", LogLevel.NORMAL);
+#endif
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Keep tracked sources and learned state for a new listener (or after a suspension),
+	// re-validating all of them on the next tick, then searching and refreshing at full rate for
+	// a short burst while speeds and smoothing settle again
+	//------------------------------------------------------------------------------------------------
+	void Retarget(float originalAuditoryRange)
+	{
+		m_fOriginalAuditoryRange = originalAuditoryRange;
+		m_vCachedPlayerDir = m_Input.GetListenerForward();
+		m_iUpdateCounter = 0;
+		m_iBurstTicks = RETARGET_BURST_TICKS;
+		m_Sweep.Restart();
+
+		float currentTime = m_Clock.GetMs();
+		foreach (VSC_TrackedSoundSource source : m_aTrackedSources)
+		{
+			m_RefreshQueue.Schedule(source, currentTime);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Stop processing and drop tracked sources
+	//------------------------------------------------------------------------------------------------
+	void Deactivate()
+	{
+		if (!m_bIsActive)
+			return;
+
+		m_bIsActive = false;
+		ClearTrackedSources();
+
+#ifndef VSC_NO_LOGGING
+		Print("[VSC BOSSA] Algorithm deactivated. Hearing restored to normal.", LogLevel.NORMAL);
+#endif
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Auditory range multiplier contributed by the BOSSA stages
+	//------------------------------------------------------------------------------------------------
+	float GetGain()
+	{
+		if (!m_bIsActive)
+			return 1.0;
+
+		return m_fSpatialGain * m_fAttentionGain;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Main BOSSA processing loop - mimics brain's continuous sound processing
+	// Called on every controller tick (50ms)
+	//------------------------------------------------------------------------------------------------
+	void Update()
+	{
+		if (!m_bIsActive)
+			return;
+
+		float currentTime = m_Clock.GetMs();
+		m_fReverberation = m_Input.GetListenerAcoustics().m_fHardSurfaces;
+
+		// Update cached player direction (less frequently for performance)
+		if (m_Clock.HasElapsed(m_fLastDirUpdateTime, DIRECTION_REFRESH_MS))
+		{
+			vector playerDir = m_Input.GetListenerForward();
+			if (playerDir != m_vCachedPlayerDir)
+			{
+				m_vCachedPlayerDir = playerDir;
+				UpdateSourceAngles(currentTime);
+			}
+
+			m_fLastDirUpdateTime = currentTime;
+		}
+
+		int startTick;
+		if (m_Stats)
+			startTick = System.GetTickCount();
+
+		// Refresh only the sources that are due
+		RefreshDueSources(currentTime);
+
+#ifndef VSC_NO_ADAPTIVE_LEARNING
+		m_iUpdateCounter++;
+		if (m_iUpdateCounter >= STAGGERED_UPDATE_INTERVAL)
+			m_iUpdateCounter = 0;
+#endif
+
+		// Search a slice of the surroundings for stronger sound sources every tick
+		int regionCount = SWEEP_REGIONS_PER_TICK;
+		if (m_iBurstTicks > 0)
+		{
+			m_iBurstTicks--;
+			regionCount = m_Sweep.GetRegionCount();
+		}
+
+		UpdateTrackedSources(currentTime, regionCount);
+		RefreshClusters(currentTime);
+
+		if (m_Stats)
+			m_Stats.Add(EVSC_Stage.TRACKING, startTick);
+
+		if (m_Stats)
+			startTick = System.GetTickCount();
+
+		// Always apply filtering (lightweight operations)
+		ApplySpatialFiltering();
+		ApplySelectiveAttention();
+
+#ifndef VSC_NO_ADAPTIVE_LEARNING
+		// Adaptive learning (if enabled) - less frequent
+		if (m_Profile.m_bAdaptiveLearning && m_iUpdateCounter == 0)
+		{
+			UpdateAdaptiveLearning();
+		}
+#endif
+
+		if (m_Stats)
+			m_Stats.Add(EVSC_Stage.FILTERING, startTick);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetTrackedSourceCount()
+	{
+		return m_aTrackedSources.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Source refreshes performed since activation
+	//------------------------------------------------------------------------------------------------
+	int GetRefreshCount()
+	{
+		return m_iRefreshCount;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Tracked sources for inspection (debug overlay) - do not modify
+	//------------------------------------------------------------------------------------------------
+	array<ref VSC_TrackedSoundSource> GetTrackedSources()
+	{
+		return m_aTrackedSources;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Distant sources held in clusters rather than tracked individually
+	//------------------------------------------------------------------------------------------------
+	int GetClusteredSourceCount()
+	{
+		return m_Clusters.GetMemberCount();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Virtual sources for inspection (debug overlay) - do not modify
+	//------------------------------------------------------------------------------------------------
+	array<ref VSC_SourceCluster> GetSourceClusters()
+	{
+		return m_Clusters.GetClusters();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Tracked sources and clusters by direction and distance band - do not modify
+	//------------------------------------------------------------------------------------------------
+	VSC_SectorHistogram GetSectorHistogram()
+	{
+		return m_Histogram;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Attention cone currently used by spatial filtering, in degrees
+	//------------------------------------------------------------------------------------------------
+	float GetAttentionConeAngle()
+	{
+#ifndef VSC_NO_ADAPTIVE_LEARNING
+		if (m_Profile.m_bAdaptiveLearning)
+			return m_fLearnedAttentionAngle;
+#endif
+
+		return m_Profile.m_fAttentionConeAngle;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Front enhancement currently used by spatial filtering
+	//------------------------------------------------------------------------------------------------
+	float GetEnhancementLevel()
+	{
+#ifndef VSC_NO_ADAPTIVE_LEARNING
+		if (m_Profile.m_bAdaptiveLearning)
+			return m_fLearnedEnhancementLevel;
+#endif
+
+		return m_Profile.m_fFrontEnhancementMultiplier;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	float GetLearnedAttentionAngle()
+	{
+		return m_fLearnedAttentionAngle;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// A source was deleted from the world - drop it now rather than at its next refresh
+	//------------------------------------------------------------------------------------------------
+	void OnSourceDeleted(string id)
+	{
+		VSC_TrackedSoundSource source;
+		if (m_mTrackedById.Find(id, source))
+			RemoveTrackedSource(source);
+		else
+			m_Clusters.Remove(id); // Its empty cluster leaves the histogram on the next tick
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Source currently held in the top-K table
+	//------------------------------------------------------------------------------------------------
+	bool IsTracking(string id)
+	{
+		return m_mTrackedById.Contains(id);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Keep the K most important sound sources in the environment - O(n log K) per searched region
+	//------------------------------------------------------------------------------------------------
+	protected void UpdateTrackedSources(float currentTime, int regionCount)
+	{
+		// Find nearby sound sources
+		vector playerPos = m_Input.GetListenerOrigin();
+
+		// Use more conservative search range for performance
+		float searchRange = m_fOriginalAuditoryRange * 1.5; // Reduced from full enhancement multiplier
+		m_aQueryResults.Clear();
+		m_Sweep.Step(m_Input, searchRange, regionCount, m_aQueryResults);
+
+		// Process found sources (only currently audible entities are returned)
+		// Tracked sources are kept up to date by the refresh queue, only candidates are scored here
+		foreach (VSC_SourceSample sample : m_aQueryResults)
+		{
+			if (m_mTrackedById.Contains(sample.m_sId))
+				continue;
+
+			if (m_aTrackedSources.Count() >= m_Profile.m_iMaxTrackedSources)
+			{
+				VSC_TrackedSoundSource weakest = m_ImportanceHeap.Peek();
+				if (!weakest || !OutranksSource(sample, playerPos, weakest.m_fImportance))
+				{
+					ClusterSource(sample, playerPos, currentTime);
+					continue;
+				}
+
+				RemoveTrackedSource(weakest);
+			}
+
+			m_Clusters.Remove(sample.m_sId);
+			TrackSoundSource(sample.m_sId, sample.m_EntityId, sample.m_iClassFlags, sample.m_vPosition, playerPos, m_vCachedPlayerDir, currentTime);
+		}
+		m_aQueryResults.Clear();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// A candidate that did not make the top-K: distant ones join the cluster of their grid cell
+	//------------------------------------------------------------------------------------------------
+	protected void ClusterSource(VSC_SourceSample sample, vector playerPos, float currentTime)
+	{
+		float distance = vector.Distance(sample.m_vPosition, playerPos);
+		if (distance < CLUSTER_DISTANCE)
+		{
+			m_Clusters.Remove(sample.m_sId); // Came near, competes for a slot or is dropped
+			return;
+		}
+
+		float intensity = CalculateSoundIntensity(sample.m_iClassFlags, distance);
+		m_Clusters.Update(sample.m_sId, sample.m_vPosition, intensity, IsImportantSound(sample.m_iClassFlags), currentTime);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Re-bin every cluster from its centroid and summed intensity, dropping emptied ones.
+	// O(clusters), bounded by the grid cells within the search range.
+	//------------------------------------------------------------------------------------------------
+	protected void RefreshClusters(float currentTime)
+	{
+		m_Clusters.Expire(currentTime, CLUSTER_EXPIRY_MS, CLUSTER_EXPIRY_CHECKS);
+
+		vector playerPos = m_Input.GetListenerOrigin();
+		array<ref VSC_SourceCluster> clusters = m_Clusters.GetClusters();
+
+		// Backwards, a removed cluster's slot is taken by one already refreshed
+		for (int i = clusters.Count() - 1; i >= 0; i--)
+		{
+			VSC_SourceCluster cluster = clusters[i];
+			if (cluster.m_iMemberCount == 0)
+			{
+				m_Histogram.Remove(cluster);
+				m_Clusters.RemoveCluster(cluster);
+				continue;
+			}
+
+			vector relativePos = cluster.GetCentroid() - playerPos;
+			float distance = relativePos.Length();
+			vector toSource = relativePos;
+			if (distance > 0.001)
+				toSource = toSource / distance;
+
+			cluster.m_fDistance = distance;
+			cluster.m_vRelativePosition = relativePos;
+			cluster.m_vDirection = toSource;
+			cluster.m_fAngle = CalculateAngle(toSource, m_vCachedPlayerDir);
+			cluster.m_bOnLeft = IsOnLeft(toSource, m_vCachedPlayerDir);
+			cluster.m_fIntensity = cluster.m_fIntensitySum;
+			cluster.m_bIsImportant = cluster.m_iImportantCount > 0;
+			cluster.m_bIsFootstep = false; // Footsteps do not carry this far
+			cluster.m_fLastUpdateTime = currentTime;
+
+			UpdateCoherence(cluster, currentTime, cluster.m_iHistogramBin < 0);
+			cluster.m_fImportance = CalculateImportance(0, cluster.m_fSmoothedIntensity, cluster.m_fSmoothedAngle);
+			m_Histogram.Update(cluster);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Whether an untracked candidate scores above the given importance
+	//------------------------------------------------------------------------------------------------
+	protected bool OutranksSource(VSC_SourceSample sample, vector playerPos, float importance)
+	{
+		vector toSource = sample.m_vPosition - playerPos;
+		float distance = toSource.Length();
+		float intensity = CalculateSoundIntensity(sample.m_iClassFlags, distance);
+		float categoryImportance = CalculateImportance(sample.m_iClassFlags, intensity, 180.0); // Outside the cone
+
+		// Even inside the attention cone it could not win - skip the angle
+		if (categoryImportance * ATTENTION_CONE_IMPORTANCE <= importance)
+			return false;
+
+		if (distance > 0.001)
+			toSource = toSource / distance;
+
+		float angle = CalculateAngle(toSource, m_vCachedPlayerDir);
+		return CalculateImportance(sample.m_iClassFlags, intensity, angle) > importance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Importance score: intensity x category x attention cone weight
+	//------------------------------------------------------------------------------------------------
+	protected float CalculateImportance(int classFlags, float intensity, float angle)
+	{
+		float importance = intensity;
+
+		// Footsteps get highest priority (they're quiet but critical)
+		if (IsFootstepSound(classFlags))
+			importance *= 3.0; // Strong boost for footsteps
+		else if (IsImportantSound(classFlags))
+			importance *= 2.0; // Boost important sounds
+
+		// Prefer sounds in attention cone
+		if (angle <= GetAttentionConeAngle() / 2.0)
+			importance *= ATTENTION_CONE_IMPORTANCE;
+
+		return importance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Refresh tracked sources whose scheduled refresh time has come, dropping lost or silent ones
+	//------------------------------------------------------------------------------------------------
+	protected void RefreshDueSources(float currentTime)
+	{
+		vector playerPos = m_Input.GetListenerOrigin();
+		float searchRange = m_fOriginalAuditoryRange * 1.5;
+		float searchRangeSq = searchRange * searchRange;
+
+		// Every refresh reschedules at least MIN_REFRESH_INTERVAL_MS ahead, so this terminates
+		VSC_TrackedSoundSource source = m_RefreshQueue.Peek();
+		while (source && source.m_fNextRefreshTime <= currentTime)
+		{
+			vector sourcePos;
+			int classFlags;
+			if (!m_Input.GetSourceState(source, sourcePos, classFlags) || vector.DistanceSq(playerPos, sourcePos) > searchRangeSq)
+				RemoveTrackedSource(source);
+			else
+				TrackSoundSource(source.m_sId, source.m_EntityId, classFlags, sourcePos, playerPos, m_vCachedPlayerDir, currentTime);
+
+			source = m_RefreshQueue.Peek();
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Time until a source may have moved noticeably, from its distance and relative speed (m/ms)
+	//------------------------------------------------------------------------------------------------
+	protected float CalculateRefreshInterval(float distance, float speed)
+	{
+		float tolerance = REFRESH_TOLERANCE + distance * REFRESH_TOLERANCE_PER_METER;
+		if (speed * MAX_REFRESH_INTERVAL_MS <= tolerance)
+			return MAX_REFRESH_INTERVAL_MS;
+
+		return Math.Max(tolerance / speed, MIN_REFRESH_INTERVAL_MS);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Listener turned: re-derive angles from the cached source directions, no entity access
+	//------------------------------------------------------------------------------------------------
+	protected void UpdateSourceAngles(float currentTime)
+	{
+		foreach (VSC_TrackedSoundSource source : m_aTrackedSources)
+		{
+			source.m_fAngle = CalculateAngle(source.m_vDirection, m_vCachedPlayerDir);
+			source.m_bOnLeft = IsOnLeft(source.m_vDirection, m_vCachedPlayerDir);
+			UpdateCoherence(source, currentTime, false);
+			UpdateRank(source);
+			m_Histogram.Update(source);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Exponentially weighted intensity, angle and persistence - O(1) per refresh
+	// The filter kernels read these, so a single noisy sample no longer flips the gain
+	//------------------------------------------------------------------------------------------------
+	protected void UpdateCoherence(VSC_TrackedSoundSource source, float currentTime, bool isNew)
+	{
+		if (!m_Profile.m_bUseTemporalCoherence)
+		{
+			source.m_fSmoothedIntensity = source.m_fIntensity;
+			source.m_fSmoothedAngle = source.m_fAngle;
+			source.m_fPersistence = 1.0;
+			return;
+		}
+
+		if (isNew)
+		{
+			source.m_fSmoothedIntensity = source.m_fIntensity;
+			source.m_fSmoothedAngle = source.m_fAngle;
+			source.m_fPersistence = 0.0;
+		}
+		else
+		{
+			float deltaMs = currentTime - source.m_fLastSmoothTime;
+			float windowMs = VSC_Clock.SecondsToMs(m_Profile.m_fTemporalWindow);
+
+			float alpha = GetSmoothingFactor(deltaMs, windowMs);
+			source.m_fSmoothedIntensity += (source.m_fIntensity - source.m_fSmoothedIntensity) * alpha;
+			source.m_fSmoothedAngle += (source.m_fAngle - source.m_fSmoothedAngle) * alpha;
+
+			// Persistence approaches 1 the longer a source stays audible (a speaking teammate)
+			float persistenceAlpha = GetSmoothingFactor(deltaMs, windowMs * PERSISTENCE_WINDOWS);
+			source.m_fPersistence += (1.0 - source.m_fPersistence) * persistenceAlpha;
+		}
+
+		source.m_fLastSmoothTime = currentTime;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// First-order smoothing weight for irregular refresh intervals
+	//------------------------------------------------------------------------------------------------
+	protected float GetSmoothingFactor(float deltaMs, float windowMs)
+	{
+		if (windowMs <= 0.0 || deltaMs <= 0.0)
+			return 1.0;
+
+		return deltaMs / (deltaMs + windowMs);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Re-score a tracked source from its smoothed state and restore heap order
+	//------------------------------------------------------------------------------------------------
+	protected void UpdateRank(VSC_TrackedSoundSource source)
+	{
+		float importance = CalculateImportance(source.m_iClassFlags, source.m_fSmoothedIntensity, source.m_fSmoothedAngle);
+
+		// Persistent sources hold their slot against newcomers of similar strength
+		if (m_Profile.m_bUseTemporalCoherence)
+			importance *= 1.0 + source.m_fPersistence * PERSISTENCE_IMPORTANCE;
+
+		source.m_fImportance = importance;
+		m_ImportanceHeap.Update(source);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Angle in degrees between a unit source direction and the player's forward direction
+	//------------------------------------------------------------------------------------------------
+	protected float CalculateAngle(vector toSource, vector playerDir)
+	{
+		float playerDirLen = playerDir.Length();
+		if (playerDirLen > 0.001)
+			playerDir = playerDir / playerDirLen;
+
+		// Calculate angle from player's forward direction
+		float dotProduct = vector.Dot(toSource, playerDir);
+		// Clamp dot product to valid range for acos
+		dotProduct = Math.Clamp(dotProduct, -1.0, 1.0);
+		// Use approximate acos calculation (acos in radians, convert to degrees)
+		float angleRad = Math.Acos(dotProduct);
+		return angleRad * 57.295779513; // RAD2DEG constant
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Whether a unit source direction lies left of the player's forward direction
+	//------------------------------------------------------------------------------------------------
+	protected bool IsOnLeft(vector toSource, vector playerDir)
+	{
+		return playerDir[0] * toSource[2] - playerDir[2] * toSource[0] > 0.0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void RemoveTrackedSource(VSC_TrackedSoundSource source)
+	{
+		m_RefreshQueue.Remove(source);
+		m_ImportanceHeap.Remove(source);
+		m_Histogram.Remove(source);
+		m_mTrackedById.Remove(source.m_sId);
+
+		// Unordered removal, the last source takes the freed slot
+		int index = source.m_iTrackedIndex;
+		source.m_iTrackedIndex = -1;
+		m_aTrackedSources.Remove(index);
+		if (index < m_aTrackedSources.Count())
+			m_aTrackedSources[index].m_iTrackedIndex = index;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void ClearTrackedSources()
+	{
+		m_RefreshQueue.Clear();
+		m_ImportanceHeap.Clear();
+		m_Histogram.Clear();
+		m_mTrackedById.Clear();
+		m_aTrackedSources.Clear();
+		m_Clusters.Clear();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Track a sound source, calculate spatial properties and schedule its next refresh
+	//------------------------------------------------------------------------------------------------
+	protected void TrackSoundSource(string id, EntityID entityId, int classFlags, vector sourcePos, vector playerPos, vector playerDir, float currentTime)
+	{
+		vector relativePos = sourcePos - playerPos;
+		float distance = relativePos.Length();
+
+		// Normalize direction vector
+		vector toSource = relativePos;
+		if (distance > 0.001)
+			toSource = toSource / distance;
+
+		// Find or create tracked source
+		VSC_TrackedSoundSource trackedSource = m_mTrackedById.Get(id);
+
+		// Relative speed since the last refresh (unknown for new sources)
+		float speed = -1.0;
+		bool isNew = !trackedSource;
+		if (isNew)
+		{
+			if (m_aTrackedSources.Count() >= m_Profile.m_iMaxTrackedSources)
+				return; // Too many sources
+
+			trackedSource = new VSC_TrackedSoundSource();
+			trackedSource.m_sId = id;
+			trackedSource.m_EntityId = entityId;
+			trackedSource.m_iTrackedIndex = m_aTrackedSources.Insert(trackedSource);
+			m_mTrackedById.Insert(id, trackedSource);
+		}
+		else if (currentTime > trackedSource.m_fLastUpdateTime)
+		{
+			speed = vector.Distance(relativePos, trackedSource.m_vRelativePosition) / (currentTime - trackedSource.m_fLastUpdateTime);
+		}
+
+		// Update source properties (activity may have changed since the last refresh)
+		trackedSource.m_iClassFlags = classFlags;
+		trackedSource.m_fDistance = distance;
+		trackedSource.m_vRelativePosition = relativePos;
+		trackedSource.m_vDirection = toSource;
+		trackedSource.m_fAngle = CalculateAngle(toSource, playerDir);
+		trackedSource.m_bOnLeft = IsOnLeft(toSource, playerDir);
+		trackedSource.m_fLastUpdateTime = currentTime;
+		m_iRefreshCount++;
+
+		// New sources are refreshed on the next tick to measure their speed, as is everything during
+		// a retarget burst (speeds measured across a suspension or possession change are meaningless)
+		float interval = MIN_REFRESH_INTERVAL_MS;
+		if (speed >= 0.0 && m_iBurstTicks == 0)
+			interval = CalculateRefreshInterval(distance, speed);
+
+		m_RefreshQueue.Schedule(trackedSource, currentTime + interval);
+
+		trackedSource.m_bIsImportant = IsImportantSound(classFlags);
+		trackedSource.m_bIsFootstep = IsFootstepSound(classFlags);
+
+		// Calculate intensity (simplified - would use actual audio levels in real implementation)
+		trackedSource.m_fIntensity = CalculateSoundIntensity(classFlags, distance);
+
+		UpdateCoherence(trackedSource, currentTime, isNew);
+		UpdateRank(trackedSource);
+		m_Histogram.Update(trackedSource);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Determine if a sound source is "important" (voice, movement, combat)
+	// Enhanced for footstep detection
+	//------------------------------------------------------------------------------------------------
+	protected bool IsImportantSound(int classFlags)
+	{
+		// Only what the character is doing right now counts
+		if ((classFlags & EVSC_SourceClass.CHARACTER) && (classFlags & EVSC_SourceClass.MOVEMENT) && m_Profile.m_bEnhanceMovement)
+			return true;
+
+		if ((classFlags & EVSC_SourceClass.VOICE) && m_Profile.m_bEnhanceVoices)
+			return true;
+
+		if ((classFlags & EVSC_SourceClass.WEAPON) && m_Profile.m_bEnhanceCombat)
+			return true;
+
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Check if sound source is specifically a footstep/movement sound
+	//------------------------------------------------------------------------------------------------
+	protected bool IsFootstepSound(int classFlags)
+	{
+		if (!m_Profile.m_bEnhanceMovement)
+			return false;
+
+		return (classFlags & EVSC_SourceClass.CHARACTER) && (classFlags & EVSC_SourceClass.MOVEMENT);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Calculate sound intensity (simplified model)
+	// Enhanced for footsteps - they need to be clearly audible
+	//------------------------------------------------------------------------------------------------
+	protected float CalculateSoundIntensity(int classFlags, float distance)
+	{
+		// Base intensity decreases with distance (inverse square law simplified)
+		float baseIntensity = 1.0 / (1.0 + distance * 0.1);
+
+		// Special handling for footsteps - they're quieter but need to be heard
+		if (IsFootstepSound(classFlags))
+		{
+			// Footsteps get significant boost to ensure they're audible
+			// Compensate for their naturally lower volume
+			baseIntensity *= 2.5; // Strong boost for footsteps
+
+			// Further boost for close footsteps (within 30m)
+			if (distance < 30.0)
+				baseIntensity *= 1.3;
+		}
+		// Boost for other important sounds
+		else if (IsImportantSound(classFlags))
+		{
+			baseIntensity *= 1.5;
+		}
+
+		return baseIntensity;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Apply spatial filtering - enhance sounds in attention cone, suppress background
+	// This mimics the brain's directional processing
+	//------------------------------------------------------------------------------------------------
+	protected void ApplySpatialFiltering()
+	{
+		float frontPresence = 0.0;
+		float backgroundSuppression = 0.0;
+		int frontCount = 0;
+		int backCount = 0;
+
+		// Use learned angle if adaptive learning is enabled
+		float halfAngle = GetAttentionConeAngle() / 2.0;
+
+		// Per-sector sums of smoothed values and persistence weights (raw values and full weight
+		// without coherence) - O(sectors) regardless of the number of tracked sources
+		for (int sector = 0; sector < VSC_SectorHistogram.SECTOR_COUNT; sector++)
+		{
+			int count = m_Histogram.GetCount(sector);
+			if (count == 0)
+				continue;
+
+			if (VSC_SectorHistogram.IsInCone(sector, halfAngle))
+			{
+				// Sounds in attention cone - enhance
+				frontPresence = Math.Max(frontPresence, m_Histogram.GetPresence(sector));
+				frontCount += count;
+			}
+			else
+			{
+				// Sounds are background noise - suppress
+				backgroundSuppression += m_Histogram.GetBackground(sector) * (1.0 + REVERB_SUPPRESSION * m_fReverberation);
+				backCount += count;
+			}
+		}
+
+		// Calculate dynamic range adjustment
+		float enhancementFactor = 1.0;
+		if (frontCount > 0)
+		{
+			// Enhance front sounds, fading in as they persist
+			enhancementFactor = 1.0 + (GetEnhancementLevel() - 1.0) * frontPresence;
+		}
+
+		if (backCount > 0 && m_Profile.m_fInhibitoryStrength > 0.0)
+		{
+			// Suppress background using inhibitory filtering (competing sounds outside the cone)
+			float suppression = 1.0 - (backgroundSuppression / (backCount + 1.0)) * m_Profile.m_fInhibitoryStrength * m_Profile.m_fBackgroundSuppressionMultiplier;
+			enhancementFactor *= Math.Clamp(suppression, m_Profile.m_fBackgroundSuppressionMultiplier, 1.0);
+		}
+
+		m_fSpatialGain = enhancementFactor;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Apply selective attention - enhance important sound categories
+	// Enhanced to prioritize footsteps
+	//------------------------------------------------------------------------------------------------
+	protected void ApplySelectiveAttention()
+	{
+		// Strongest persistence of important sounds and footsteps, tracked separately
+		float importantPresence = 0.0;
+		float footstepPresence = 0.0;
+		float halfAngle = GetAttentionConeAngle() / 2.0;
+
+		for (int sector = 0; sector < VSC_SectorHistogram.SECTOR_COUNT; sector++)
+		{
+			if (!VSC_SectorHistogram.IsInCone(sector, halfAngle))
+				continue;
+
+			footstepPresence = Math.Max(footstepPresence, m_Histogram.GetFootstepPresence(sector));
+			importantPresence = Math.Max(importantPresence, m_Histogram.GetImportantPresence(sector));
+		}
+
+		// Apply boosting - footsteps get extra boost, each faded in by persistence
+		float boostMultiplier = 1.0;
+
+		// Footsteps get additional boost to ensure audibility
+		float footstepBoost = m_Profile.m_fImportantSoundMultiplier * 1.4; // Extra boost for footsteps
+		boostMultiplier = Math.Max(boostMultiplier, 1.0 + (footstepBoost - 1.0) * footstepPresence);
+		boostMultiplier = Math.Max(boostMultiplier, 1.0 + (m_Profile.m_fImportantSoundMultiplier - 1.0) * importantPresence);
+
+		m_fAttentionGain = boostMultiplier;
+	}
+
+#ifndef VSC_NO_ADAPTIVE_LEARNING
+	//------------------------------------------------------------------------------------------------
+	// Update adaptive learning based on player behavior
+	//------------------------------------------------------------------------------------------------
+	protected void UpdateAdaptiveLearning()
+	{
+		// Simple adaptive learning: adjust attention angle based on where important sounds are
+		float avgImportantAngle = 0.0;
+		int importantCount = 0;
+
+		for (int sector = 0; sector < VSC_SectorHistogram.SECTOR_COUNT; sector++)
+		{
+			avgImportantAngle += m_Histogram.GetImportantAngle(sector);
+			importantCount += m_Histogram.GetImportantCount(sector);
+		}
+
+		if (importantCount > 0)
+		{
+			avgImportantAngle /= importantCount;
+
+			// Gradually adjust learned angle toward where important sounds are
+			float targetAngle = avgImportantAngle * 2.0; // Expand to cover important sounds
+			// Manual lerp: lerp(a, b, t) = a + (b - a) * t
+			float lerpFactor = m_Profile.m_fAdaptationRate * 0.1;
+			m_fLearnedAttentionAngle = m_fLearnedAttentionAngle + (targetAngle - m_fLearnedAttentionAngle) * lerpFactor;
+			m_fLearnedAttentionAngle = Math.Clamp(m_fLearnedAttentionAngle, 30.0, 90.0);
+
+			// Publish for the next life, the owner of the state decides when to persist it
+			if (m_LearnedState)
+			{
+				m_LearnedState.m_bValid = true;
+				m_LearnedState.m_fAttentionAngle = m_fLearnedAttentionAngle;
+				m_LearnedState.m_fEnhancementLevel = m_fLearnedEnhancementLevel;
+				m_LearnedState.m_iUpdateCount++;
+			}
+		}
+	}
+#endif
+}
+
+//------------------------------------------------------------------------------------------------
+// Data structure for tracking sound sources
+//------------------------------------------------------------------------------------------------
+class VSC_TrackedSoundSource
+{
+	string m_sId;
+	EntityID m_EntityId = EntityID.INVALID; // Live input only, resolved through the world on refresh
+	int m_iTrackedIndex = -1; // Slot in the tracked source list, for O(1) removal
+	int m_iClassFlags; // EVSC_SourceClass
+	float m_fDistance;
+	float m_fAngle; // Angle from player's forward direction in degrees
+	bool m_bOnLeft; // Side of the player's forward direction, for the signed histogram azimuth
+	float m_fIntensity;
+	bool m_bIsImportant;
+	bool m_bIsFootstep; // Specifically tracks if this is a footstep sound
+	float m_fLastUpdateTime;
+	vector m_vRelativePosition; // Source position relative to the listener at the last refresh
+	vector m_vDirection; // Unit direction from the listener at the last refresh
+	float m_fNextRefreshTime;
+	int m_iQueueIndex = -1; // Slot in VSC_RefreshQueue, -1 when not queued
+	float m_fImportance; // Intensity x category x attention cone weight
+	int m_iRankIndex = -1; // Slot in VSC_ImportanceHeap, -1 when not ranked
+
+	// Temporal coherence state, read by the filter kernels
+	float m_fSmoothedIntensity;
+	float m_fSmoothedAngle;
+	float m_fPersistence; // 0 = just appeared, 1 = continuously present
+	float m_fLastSmoothTime;
+
+	// Contribution to VSC_SectorHistogram, taken back on the next update or removal
+	int m_iHistogramBin = -1; // -1 when not binned
+	float m_fBinPresence;
+	float m_fBinIntensity;
+	float m_fBinAngle;
+	bool m_bBinImportant;
+	bool m_bBinFootstep;
+
+	void VSC_TrackedSoundSource()
+	{
+		m_iClassFlags = 0;
+		m_fDistance = 0.0;
+		m_fAngle = 0.0;
+		m_fIntensity = 0.0;
+		m_bIsImportant = false;
+		m_bIsFootstep = false;
+		m_fLastUpdateTime = 0.0;
+	}
+}
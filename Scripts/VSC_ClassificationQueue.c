@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Classification Queue
+// Entities seen for the first time wait here for their component lookups, which are done a fixed
+// number per tick in discovery order. A helicopter unloading a squad or turning a corner into a
+// town spreads over a few ticks instead of landing in one. Each entity is queued once, however
+// often it is found again while it waits.
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+class VSC_ClassificationQueue
+{
+	private ref array<ref VSC_SourceSample> m_aPending = {};
+	private ref map<string, VSC_SourceSample> m_mPendingById = new map<string, VSC_SourceSample>();
+	private int m_iHead = 0; // First pending entry, consumed entries before it are compacted away
+
+	//------------------------------------------------------------------------------------------------
+	// Queue an entity for classification, false if it is already waiting
+	//------------------------------------------------------------------------------------------------
+	bool Enqueue(string id, EntityID entityId)
+	{
+		if (m_mPendingById.Contains(id))
+			return false;
+
+		VSC_SourceSample sample = new VSC_SourceSample();
+		sample.m_sId = id;
+		sample.m_EntityId = entityId;
+		m_aPending.Insert(sample);
+		m_mPendingById.Insert(id, sample);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool IsPending(string id)
+	{
+		return m_mPendingById.Contains(id);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int Count()
+	{
+		return m_aPending.Count() - m_iHead;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Hand out up to budget of the longest waiting entities
+	//------------------------------------------------------------------------------------------------
+	void Take(int budget, notnull array<ref VSC_SourceSample> outSamples)
+	{
+		int end = Math.Min(m_iHead + budget, m_aPending.Count());
+		for (int i = m_iHead; i < end; i++)
+		{
+			VSC_SourceSample sample = m_aPending[i];
+			m_mPendingById.Remove(sample.m_sId);
+			outSamples.Insert(sample);
+		}
+
+		m_iHead = end;
+
+		// Drop consumed entries once they make up most of the array
+		if (m_iHead == m_aPending.Count())
+		{
+			m_aPending.Clear();
+			m_iHead = 0;
+		}
+		else if (m_iHead > 64 && m_iHead * 2 > m_aPending.Count())
+		{
+			array<ref VSC_SourceSample> remaining = {};
+			for (int j = m_iHead; j < m_aPending.Count(); j++)
+			{
+				remaining.Insert(m_aPending[j]);
+			}
+
+			m_aPending = remaining;
+			m_iHead = 0;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Clear()
+	{
+		m_aPending.Clear();
+		m_mPendingById.Clear();
+		m_iHead = 0;
+	}
+}
@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Clock
+// Time of the current tick or frame, sampled once and read by everything that runs in it. All VSC
+// times are world time in milliseconds; tuning given in seconds is converted with SecondsToMs
+// before it is compared. A pipeline samples its input's time (world time live, frame time in
+// replays and tests), live code outside a pipeline samples the shared world clock. Sampling the
+// same time again returns at once and keeps the delta, so any number of entry points may sample
+// in one frame.
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+class VSC_Clock
+{
+	private static ref VSC_Clock s_World;
+
+	private float m_fTimeMs;
+	private float m_fDeltaMs;
+	private bool m_bSampled;
+
+	//------------------------------------------------------------------------------------------------
+	// Shared clock on world time, as of its last sample
+	//------------------------------------------------------------------------------------------------
+	static VSC_Clock GetWorldClock()
+	{
+		if (!s_World)
+			s_World = new VSC_Clock();
+
+		return s_World;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Sample world time into the shared clock (unchanged while there is no world)
+	//------------------------------------------------------------------------------------------------
+	static VSC_Clock SampleWorld()
+	{
+		VSC_Clock clock = GetWorldClock();
+		BaseWorld world = GetGame().GetWorld();
+		if (world)
+			clock.Sample(world.GetWorldTime());
+
+		return clock;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static float SecondsToMs(float seconds)
+	{
+		return seconds * 1000.0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Advance to a new time; the delta is 0 on the first sample and after Reset
+	//------------------------------------------------------------------------------------------------
+	void Sample(float timeMs)
+	{
+		if (m_bSampled && timeMs == m_fTimeMs)
+			return;
+
+		m_fDeltaMs = 0.0;
+		if (m_bSampled)
+			m_fDeltaMs = timeMs - m_fTimeMs;
+
+		m_fTimeMs = timeMs;
+		m_bSampled = true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Reset()
+	{
+		m_fTimeMs = 0.0;
+		m_fDeltaMs = 0.0;
+		m_bSampled = false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	float GetMs()
+	{
+		return m_fTimeMs;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	float GetSeconds()
+	{
+		return m_fTimeMs * 0.001;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Time between the last two distinct samples
+	//------------------------------------------------------------------------------------------------
+	float GetDeltaMs()
+	{
+		return m_fDeltaMs;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	float GetDeltaSeconds()
+	{
+		return m_fDeltaMs * 0.001;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Whether at least intervalMs have passed since sinceMs (a time read from this clock)
+	//------------------------------------------------------------------------------------------------
+	bool HasElapsed(float sinceMs, float intervalMs)
+	{
+		return m_fTimeMs - sinceMs >= intervalMs;
+	}
+}
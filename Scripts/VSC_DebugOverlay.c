@@ -0,0 +1,198 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Debug Overlay
+// In-world view of the local pipeline: attention cone, tracked sources (colour = category,
+// size = importance, opacity = persistence), current gains and dampening. Toggled through
+// DiagMenu (VSC > Show BOSSA overlay). Compiled into diag client builds only; the local controller
+// drives the per-frame draw only while the toggle is on. The VSC Tuning submenu edits the most
+// used parameters through the same path as the #vsc command (see VSC_Tuning).
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+#ifdef ENABLE_DIAG
+#ifndef VSC_SERVER_LITE
+modded enum SCR_DebugMenuID
+{
+	VSC_MENU,
+	VSC_SHOW_OVERLAY,
+	VSC_TUNING_MENU,
+	VSC_TUNING_BOOST,
+	VSC_TUNING_DAMPEN,
+	VSC_TUNING_CONE,
+	VSC_TUNING_MAX_SOURCES,
+	VSC_TUNING_TICK_MS
+}
+
+class VSC_DebugOverlay
+{
+	private static const float CONE_LENGTH = 25.0;
+	private static const int CONE_ARC_SEGMENTS = 8;
+	private static const ShapeFlags SHAPE_FLAGS = ShapeFlags.ONCE | ShapeFlags.NOZBUFFER | ShapeFlags.TRANSP;
+
+	private static const int COLOR_CONE = 0xFF00C0FF;
+	private static const int COLOR_FOOTSTEP = 0x0000FF00;
+	private static const int COLOR_IMPORTANT = 0x00FFD000;
+	private static const int COLOR_WEAPON = 0x00FF4000;
+	private static const int COLOR_OTHER = 0x00A0A0A0;
+	private static const int COLOR_DAMPENED = 0x80FF0000;
+	private static const int COLOR_TEXT = 0xFFFFFFFF;
+	private static const int COLOR_TEXT_BACKGROUND = 0x80000000;
+
+	// Tuning sliders and their parameter keys, last polled values detect changes
+	private static ref array<int> s_aTuningMenuIds = {SCR_DebugMenuID.VSC_TUNING_BOOST, SCR_DebugMenuID.VSC_TUNING_DAMPEN, SCR_DebugMenuID.VSC_TUNING_CONE, SCR_DebugMenuID.VSC_TUNING_MAX_SOURCES, SCR_DebugMenuID.VSC_TUNING_TICK_MS};
+	private static ref array<string> s_aTuningKeys = {"protection.BoostMultiplier", "protection.DampenMultiplier", "bossa.AttentionConeAngle", "bossa.MaxTrackedSources", "controller.TickIntervalMs"};
+	private static ref array<float> s_aTuningValues = {};
+
+	//------------------------------------------------------------------------------------------------
+	static void Register()
+	{
+		DiagMenu.RegisterMenu(SCR_DebugMenuID.VSC_MENU, "VSC", "");
+		DiagMenu.RegisterBool(SCR_DebugMenuID.VSC_SHOW_OVERLAY, "", "Show BOSSA overlay", "VSC");
+
+		DiagMenu.RegisterMenu(SCR_DebugMenuID.VSC_TUNING_MENU, "VSC Tuning", "VSC");
+		DiagMenu.RegisterRange(SCR_DebugMenuID.VSC_TUNING_BOOST, "", "Boost multiplier", "VSC Tuning", "1,5,1.75,0.05");
+		DiagMenu.RegisterRange(SCR_DebugMenuID.VSC_TUNING_DAMPEN, "", "Dampen multiplier", "VSC Tuning", "0.1,1,0.25,0.05");
+		DiagMenu.RegisterRange(SCR_DebugMenuID.VSC_TUNING_CONE, "", "Attention cone (deg)", "VSC Tuning", "10,180,45,5");
+		DiagMenu.RegisterRange(SCR_DebugMenuID.VSC_TUNING_MAX_SOURCES, "", "Max tracked sources", "VSC Tuning", "1,64,10,1");
+		DiagMenu.RegisterRange(SCR_DebugMenuID.VSC_TUNING_TICK_MS, "", "Tick interval (ms)", "VSC Tuning", "10,200,50,10");
+
+		s_aTuningValues.Clear();
+		foreach (int id : s_aTuningMenuIds)
+		{
+			s_aTuningValues.Insert(DiagMenu.GetRangeValue(id));
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Forward moved sliders to the controller, untouched ones leave #vsc edits alone
+	//------------------------------------------------------------------------------------------------
+	static void PollTuning(VSC_LocalController controller)
+	{
+		for (int i = 0; i < s_aTuningMenuIds.Count(); i++)
+		{
+			float value = DiagMenu.GetRangeValue(s_aTuningMenuIds[i]);
+			if (value == s_aTuningValues[i])
+				continue;
+
+			s_aTuningValues[i] = value;
+			controller.SetParameter(s_aTuningKeys[i], value.ToString());
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static bool IsEnabled()
+	{
+		return DiagMenu.GetBool(SCR_DebugMenuID.VSC_SHOW_OVERLAY);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Draw one frame of the overlay for the given listener
+	//------------------------------------------------------------------------------------------------
+	static void Draw(VSC_Pipeline pipeline, VSC_StageStats stats, vector origin, vector forward)
+	{
+		if (!pipeline || !pipeline.IsAttached())
+			return;
+
+		BaseWorld world = GetGame().GetWorld();
+		if (!world)
+			return;
+
+		vector head = origin + "0 1.7 0";
+		VSC_BOSSAProcessor bossa = pipeline.GetBOSSA();
+		if (bossa)
+		{
+			DrawCone(head, forward, bossa.GetAttentionConeAngle());
+			DrawSources(origin, head, bossa);
+		}
+
+		VSC_ProtectionProcessor protection = pipeline.GetProtection();
+		bool dampened = protection && protection.IsDampened();
+		if (dampened)
+			Shape.CreateSphere(COLOR_DAMPENED, SHAPE_FLAGS | ShapeFlags.WIREFRAME, head, 1.0);
+
+		string text = string.Format("VSC gain %1", pipeline.GetGain().ToString(-1, 2));
+		if (protection)
+			text += string.Format(" | protection %1", protection.GetGain().ToString(-1, 2));
+
+		if (bossa)
+			text += string.Format(" | BOSSA %1 (%2 sources, %3 clustered)", bossa.GetGain().ToString(-1, 2), bossa.GetTrackedSourceCount(), bossa.GetClusteredSourceCount());
+
+		if (dampened)
+			text += " | DAMPENED";
+
+		if (stats)
+		{
+			float totalMicroseconds;
+			for (int stage = 0; stage < EVSC_Stage.COUNT; stage++)
+			{
+				totalMicroseconds += stats.GetAverageMicroseconds(stage);
+			}
+
+			text += string.Format(" | %1 us/tick", totalMicroseconds.ToString(-1, 0));
+		}
+
+		vector textPos = head + "0 0.6 0" + forward * 2.0;
+		DebugTextWorldSpace.Create(world, text, DebugTextFlags.ONCE | DebugTextFlags.CENTER | DebugTextFlags.FACE_CAMERA, textPos[0], textPos[1], textPos[2], 10, COLOR_TEXT, COLOR_TEXT_BACKGROUND);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Attention cone edges and arc on the horizontal plane
+	//------------------------------------------------------------------------------------------------
+	protected static void DrawCone(vector head, vector forward, float coneAngle)
+	{
+		float halfAngle = coneAngle * 0.5 * Math.DEG2RAD;
+
+		vector previous = head + RotateYaw(forward, -halfAngle) * CONE_LENGTH;
+		Shape.Create(ShapeType.LINE, COLOR_CONE, SHAPE_FLAGS, head, previous);
+
+		for (int i = 1; i <= CONE_ARC_SEGMENTS; i++)
+		{
+			float angle = -halfAngle + 2.0 * halfAngle * i / CONE_ARC_SEGMENTS;
+			vector point = head + RotateYaw(forward, angle) * CONE_LENGTH;
+			Shape.Create(ShapeType.LINE, COLOR_CONE, SHAPE_FLAGS, previous, point);
+			previous = point;
+		}
+
+		Shape.Create(ShapeType.LINE, COLOR_CONE, SHAPE_FLAGS, head, previous);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static void DrawSources(vector origin, vector head, VSC_BOSSAProcessor bossa)
+	{
+		foreach (VSC_TrackedSoundSource source : bossa.GetTrackedSources())
+		{
+			int alpha = 64 + Math.Round(source.m_fPersistence * 191.0);
+			int color = (alpha << 24) | GetCategoryColor(source);
+			float radius = Math.Clamp(0.2 + source.m_fImportance * 0.1, 0.2, 1.0);
+
+			vector position = origin + source.m_vRelativePosition;
+			Shape.CreateSphere(color, SHAPE_FLAGS, position, radius);
+			Shape.Create(ShapeType.LINE, color, SHAPE_FLAGS, head, position);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static int GetCategoryColor(VSC_TrackedSoundSource source)
+	{
+		if (source.m_bIsFootstep)
+			return COLOR_FOOTSTEP;
+
+		if (source.m_iClassFlags & EVSC_SourceClass.WEAPON)
+			return COLOR_WEAPON;
+
+		if (source.m_bIsImportant)
+			return COLOR_IMPORTANT;
+
+		return COLOR_OTHER;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static vector RotateYaw(vector direction, float angle)
+	{
+		float sin = Math.Sin(angle);
+		float cos = Math.Cos(angle);
+		vector rotated = Vector(direction[0] * cos - direction[2] * sin, 0, direction[0] * sin + direction[2] * cos);
+		return rotated.Normalized();
+	}
+}
+#endif
+#endif
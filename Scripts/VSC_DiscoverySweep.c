@@ -0,0 +1,198 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Discovery Sweep
+// Finds new sources by querying the auditory sphere a few small regions at a time instead of in
+// one large query: a disc around the listener plus two rings of azimuth sectors, the outer ring
+// cut into twice as many sectors so its regions stay as small as the inner ones. Each region's
+// query sphere covers its slice, and each source belongs to exactly one region, so a full sweep
+// reports every audible source once. The per-tick query cost stays small and even however many
+// entities are within range.
+// Regions are slices of the horizontal plane. Sources more than VERTICAL_RANGE above or below
+// the listener may fall outside every query sphere near the slice edges.
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------------------------
+// One slice of the auditory sphere, placed around the listener for each query
+//------------------------------------------------------------------------------------------------
+class VSC_SweepRegion
+{
+	vector m_vListener;
+	vector m_vOffset; // Query centre relative to the listener
+	float m_fQueryRadius;
+	float m_fInnerFraction; // Horizontal band of the slice relative to the auditory radius
+	float m_fOuterFraction;
+	float m_fInnerRadius; // The band in metres, 0 for the central disc...
+	float m_fOuterRadius; // ...up to the auditory radius for the outer ring
+	float m_fAuditoryRadius;
+	int m_iSectorCount; // Sectors in this slice's ring, 0 = central disc
+	int m_iSector;
+
+	//------------------------------------------------------------------------------------------------
+	vector GetCenter()
+	{
+		return m_vListener + m_vOffset;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Whether a position belongs to this slice (checked before any per-entity work)
+	//------------------------------------------------------------------------------------------------
+	bool Contains(vector position)
+	{
+		vector toSource = position - m_vListener;
+		if (toSource.LengthSq() > m_fAuditoryRadius * m_fAuditoryRadius)
+			return false;
+
+		float horizontalSq = toSource[0] * toSource[0] + toSource[2] * toSource[2];
+		if (horizontalSq < m_fInnerRadius * m_fInnerRadius)
+			return false;
+
+		// The outer ring takes everything left inside the sphere
+		if (m_fOuterRadius < m_fAuditoryRadius && horizontalSq >= m_fOuterRadius * m_fOuterRadius)
+			return false;
+
+		return m_iSectorCount == 0 || VSC_DiscoverySweep.GetSector(toSource, m_iSectorCount) == m_iSector;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Rotates through the regions, a few per call
+//------------------------------------------------------------------------------------------------
+class VSC_DiscoverySweep
+{
+	static const float DISC_FRACTION = 0.25; // Disc radius relative to the auditory radius
+	static const float INNER_RING_FRACTION = 0.6; // Inner ring's outer edge relative to the auditory radius
+	static const int INNER_RING_SECTORS = 6;
+	static const int OUTER_RING_SECTORS = 12;
+	static const float VERTICAL_RANGE = 30.0; // Metres above and below the listener every region covers
+
+	protected ref array<ref VSC_SweepRegion> m_aRegions = {};
+	protected int m_iNextRegion = 0;
+	protected float m_fRadius = -1.0;
+
+	//------------------------------------------------------------------------------------------------
+	void VSC_DiscoverySweep()
+	{
+		AddRing(0, 0.0, DISC_FRACTION);
+		AddRing(INNER_RING_SECTORS, DISC_FRACTION, INNER_RING_FRACTION);
+		AddRing(OUTER_RING_SECTORS, INNER_RING_FRACTION, 1.0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Ring sector of a listener-relative direction (world azimuth, independent of facing)
+	//------------------------------------------------------------------------------------------------
+	static int GetSector(vector toSource, int sectorCount)
+	{
+		float azimuth = Math.Atan2(toSource[0], toSource[2]) * Math.RAD2DEG;
+		int sector = Math.Floor((azimuth + 180.0) * sectorCount / 360.0);
+		return Math.ClampInt(sector, 0, sectorCount - 1);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetRegionCount()
+	{
+		return m_aRegions.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Region the next query starts with
+	//------------------------------------------------------------------------------------------------
+	int GetNextRegion()
+	{
+		return m_iNextRegion;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Start the next sweep from the central disc
+	//------------------------------------------------------------------------------------------------
+	void Restart()
+	{
+		m_iNextRegion = 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Query the next regionCount regions around the listener, true if this finished a sweep
+	//------------------------------------------------------------------------------------------------
+	bool Step(VSC_InputProvider input, float radius, int regionCount, notnull array<ref VSC_SourceSample> outSamples)
+	{
+		if (radius != m_fRadius)
+			Layout(radius);
+
+		vector listener = input.GetListenerOrigin();
+		bool finished = false;
+		for (int i = 0; i < regionCount; i++)
+		{
+			VSC_SweepRegion region = m_aRegions[m_iNextRegion];
+			region.m_vListener = listener;
+			input.QueryRegion(region, outSamples);
+
+			m_iNextRegion++;
+			if (m_iNextRegion >= m_aRegions.Count())
+			{
+				m_iNextRegion = 0;
+				finished = true;
+			}
+		}
+
+		return finished;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Regions of one ring, or the central disc for 0 sectors (placed by Layout)
+	//------------------------------------------------------------------------------------------------
+	protected void AddRing(int sectorCount, float innerFraction, float outerFraction)
+	{
+		for (int sector = 0; sector < Math.Max(sectorCount, 1); sector++)
+		{
+			VSC_SweepRegion region = new VSC_SweepRegion();
+			region.m_iSectorCount = sectorCount;
+			region.m_iSector = sector;
+			region.m_fInnerFraction = innerFraction;
+			region.m_fOuterFraction = outerFraction;
+			m_aRegions.Insert(region);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Place the query spheres for an auditory radius (only when the radius changes)
+	//------------------------------------------------------------------------------------------------
+	protected void Layout(float radius)
+	{
+		m_fRadius = radius;
+		foreach (VSC_SweepRegion region : m_aRegions)
+		{
+			region.m_fAuditoryRadius = radius;
+			region.m_fInnerRadius = radius * region.m_fInnerFraction;
+			region.m_fOuterRadius = radius * region.m_fOuterFraction;
+
+			if (region.m_iSectorCount == 0)
+			{
+				region.m_vOffset = vector.Zero;
+				region.m_fQueryRadius = Math.Min(Math.Sqrt(region.m_fOuterRadius * region.m_fOuterRadius + VERTICAL_RANGE * VERTICAL_RANGE), radius);
+				continue;
+			}
+
+			// A ring sector is covered from the middle of the ring: its farthest points are its corners
+			// or the middle of its outer edge
+			float sectorWidth = 360.0 / region.m_iSectorCount;
+			float centreDistance = (region.m_fInnerRadius + region.m_fOuterRadius) * 0.5;
+			float halfWidth = sectorWidth * 0.5 * Math.DEG2RAD;
+			float coverRadius = region.m_fOuterRadius - centreDistance;
+			coverRadius = Math.Max(coverRadius, GetCornerDistance(centreDistance, region.m_fInnerRadius, halfWidth));
+			coverRadius = Math.Max(coverRadius, GetCornerDistance(centreDistance, region.m_fOuterRadius, halfWidth));
+
+			float azimuth = (-180.0 + (region.m_iSector + 0.5) * sectorWidth) * Math.DEG2RAD;
+			region.m_vOffset = Vector(Math.Sin(azimuth) * centreDistance, 0, Math.Cos(azimuth) * centreDistance);
+			region.m_fQueryRadius = Math.Sqrt(coverRadius * coverRadius + VERTICAL_RANGE * VERTICAL_RANGE);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Distance from a point on a sector's bisector to the sector edge point at the given range
+	//------------------------------------------------------------------------------------------------
+	protected static float GetCornerDistance(float centreDistance, float range, float halfWidth)
+	{
+		float x = range * Math.Cos(halfWidth) - centreDistance;
+		float y = range * Math.Sin(halfWidth);
+		return Math.Sqrt(x * x + y * y);
+	}
+}
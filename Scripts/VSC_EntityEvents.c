@@ -0,0 +1,53 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Entity Deletion Hooks
+// Reports characters and vehicles as they are deleted (AI despawn, destroyed vehicles, players
+// leaving), so the local tracker drops them at once instead of finding them gone at their next
+// refresh. Costs a null check per deletion while nobody listens (dedicated servers).
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+void VSC_OnEntityDeleted(IEntity entity);
+typedef func VSC_OnEntityDeleted;
+
+class VSC_EntityEvents
+{
+	private static ref ScriptInvokerBase<VSC_OnEntityDeleted> s_OnDeleted;
+
+	//------------------------------------------------------------------------------------------------
+	static ScriptInvokerBase<VSC_OnEntityDeleted> GetOnDeleted()
+	{
+		if (!s_OnDeleted)
+			s_OnDeleted = new ScriptInvokerBase<VSC_OnEntityDeleted>();
+
+		return s_OnDeleted;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static void NotifyDeleted(IEntity entity)
+	{
+		if (s_OnDeleted && entity)
+			s_OnDeleted.Invoke(entity);
+	}
+}
+
+modded class SCR_CharacterControllerComponent
+{
+	//------------------------------------------------------------------------------------------------
+	override void OnDelete(IEntity owner)
+	{
+		VSC_EntityEvents.NotifyDeleted(owner);
+
+		super.OnDelete(owner);
+	}
+}
+
+modded class SCR_VehicleDamageManagerComponent
+{
+	//------------------------------------------------------------------------------------------------
+	override void OnDelete(IEntity owner)
+	{
+		VSC_EntityEvents.NotifyDeleted(owner);
+
+		super.OnDelete(owner);
+	}
+}
@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Headgear Helpers
+// Headgear lookup and qualification shared by the local controller and the AI hearing system.
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+class VSC_Headgear
+{
+	//------------------------------------------------------------------------------------------------
+	// Headgear qualifies if it carries a VSC component or auto-attach is enabled
+	//------------------------------------------------------------------------------------------------
+	static bool IsQualifying(IEntity headgear, bool autoAttach)
+	{
+		if (autoAttach)
+			return true;
+
+		if (headgear.FindComponent(VSC_ActiveHearingProtectionComponent))
+			return true;
+
+		return headgear.FindComponent(VSC_BOSSAComponent) != null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Qualifying headgear of a character, or null
+	//------------------------------------------------------------------------------------------------
+	static IEntity FindQualifyingHeadgear(ChimeraCharacter character, bool autoAttach)
+	{
+		IEntity headgear = FindHeadgear(character);
+		if (headgear && IsQualifying(headgear, autoAttach))
+			return headgear;
+
+		return null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Tuning profile from the headgear's protection component, null if it has none
+	//------------------------------------------------------------------------------------------------
+	static VSC_ProtectionProfile GetProtectionProfile(IEntity headgear)
+	{
+		VSC_ActiveHearingProtectionComponent component = VSC_ActiveHearingProtectionComponent.Cast(headgear.FindComponent(VSC_ActiveHearingProtectionComponent));
+		if (component)
+			return component.GetProfile();
+
+		return null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Tuning profile from the headgear's BOSSA component, null if it has none
+	//------------------------------------------------------------------------------------------------
+	static VSC_BOSSAProfile GetBOSSAProfile(IEntity headgear)
+	{
+		VSC_BOSSAComponent component = VSC_BOSSAComponent.Cast(headgear.FindComponent(VSC_BOSSAComponent));
+		if (component)
+			return component.GetProfile();
+
+		return null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Get the character's headgear - try multiple methods to find it
+	//------------------------------------------------------------------------------------------------
+	static IEntity FindHeadgear(ChimeraCharacter character)
+	{
+		InventoryComponent inventory = InventoryComponent.Cast(character.FindComponent(InventoryComponent));
+		if (!inventory)
+			return null;
+
+		// Try common headgear slots first (InventorySlots.HEADGEAR varies per project)
+		IEntity headgear = inventory.GetItemInSlot(1);
+		if (!headgear)
+			headgear = inventory.GetItemInSlot(2);
+
+		// Fallback: search inventory for headgear items by name
+		if (!headgear)
+			headgear = FindHeadgearInInventory(inventory);
+
+		return headgear;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Find headgear item in character inventory
+	//------------------------------------------------------------------------------------------------
+	protected static IEntity FindHeadgearInInventory(InventoryComponent inventory)
+	{
+		// Try to find headgear by checking common inventory slots
+		// Most Arma Reforger headgear is in slot 1 or 2
+		array<int> headgearSlots = {1, 2, 3}; // Common headgear slots
+
+		foreach (int slot : headgearSlots)
+		{
+			IEntity item = inventory.GetItemInSlot(slot);
+			if (item)
+			{
+				// Check if item name suggests it's headgear (heuristic)
+				string itemName = item.GetName();
+				itemName.ToLower();
+				if (itemName.Contains("helmet") || itemName.Contains("cap") ||
+				    itemName.Contains("hat") || itemName.Contains("head") ||
+				    itemName.Contains("headphone") || itemName.Contains("ear") ||
+				    itemName.Contains("headset") || itemName.Contains("comms"))
+				{
+					return item;
+				}
+			}
+		}
+
+		return null;
+	}
+}
@@ -1,228 +1,154 @@
 //------------------------------------------------------------------------------------------------
 // Virtual Sound Compressor - Headgear Manager Component
-// Automatically attaches hearing protection component to headgear items when equipped
-// Optimized for server-side operation with up to 128 concurrent users
+// Starts the client-side VSC_LocalController, which treats equipped headgear as a capability
+// flag and runs hearing protection and BOSSA for the locally controlled character only, and the
+// server-side VSC_AIHearingSystem, which batches hearing protection for all AI characters.
+// Nothing is attached to headgear or characters at runtime. An optional server tuning preset
+// is replicated to clients once (requires an RplComponent on the owning entity), as is whether
+// the server collects fleet telemetry (see VSC_Telemetry).
 // Author: jcrashkit
 //------------------------------------------------------------------------------------------------
 
-[ComponentEditorProps(category: "GameScripted/Audio", description: "Automatically attaches VSC hearing protection and BOSSA to headgear items. Optimized for 128 concurrent users.")]
+[ComponentEditorProps(category: "GameScripted/Audio", description: "Enables VSC hearing protection and BOSSA for the local player's headgear. One controller per client, no runtime components on items.")]
 class VSC_HeadgearManagerComponentClass : ScriptedGameComponentClass
 {
 }
 
 class VSC_HeadgearManagerComponent : ScriptedGameComponent
 {
-	// Performance optimization: Track which items already have components to avoid duplicate work
-	private ref map<string, bool> m_mProcessedItems;
-	
-	// Performance: Cache component class to avoid repeated lookups
-	private VSC_ActiveHearingProtectionComponentClass m_ComponentClass;
-	private VSC_BOSSAComponentClass m_BOSSAClass;
-
-	// Consolidated setup: single toggle controls auto-attach of both protection and BOSSA
-	[Attribute(defvalue: "true", uiwidget: UIWidgets.CheckBox, desc: "Auto-attach VSC components (Protection + BOSSA) to headgear items (server-side).")]
+	static const string CLI_PRESET = "vscPreset";
+	static const string CLI_TELEMETRY = "vscTelemetry";
+
+	// Consolidated setup: single toggle enables protection and BOSSA on any headgear
+	[Attribute(defvalue: "true", uiwidget: UIWidgets.CheckBox, desc: "Enable VSC (Protection + BOSSA) on any headgear. When disabled, only headgear carrying VSC components qualifies.")]
 	protected bool m_bAutoAttach;
-	
+
+	[Attribute(defvalue: "true", uiwidget: UIWidgets.CheckBox, desc: "Apply hearing protection to AI characters wearing qualifying headgear (server only)")]
+	protected bool m_bEnableAIHearing;
+
+	[Attribute(defvalue: "32", uiwidget: UIWidgets.Slider, desc: "AI characters updated per frame - the whole population is processed round-robin", params: "1 512 1")]
+	protected int m_iAIUpdatesPerFrame;
+
+	[Attribute(desc: "Server-wide tuning preset replacing every headgear profile (empty = per-headgear profiles). Overridden by -vscPreset.", params: "conf class=VSC_TuningPreset")]
+	protected ResourceName m_Preset;
+
+	[Attribute(defvalue: "false", uiwidget: UIWidgets.CheckBox, desc: "Collect VSC performance reports from clients and write them to $profile:VSC/telemetry_*.json (multiplayer servers only). Also enabled by -vscTelemetry.")]
+	protected bool m_bCollectTelemetry;
+
+	// Preset the server applied, sent to each client once on connect
+	[RplProp(onRplName: "OnPresetReplicated")]
+	protected string m_sPresetResource;
+
+	// Whether the server collects telemetry, clients only send reports when it does
+	[RplProp(onRplName: "OnTelemetryReplicated")]
+	protected bool m_bTelemetryActive;
+
 	//------------------------------------------------------------------------------------------------
 	override void OnPostInit(IEntity owner)
 	{
 		super.OnPostInit(owner);
-		
-		m_mProcessedItems = new map<string, bool>();
-		// Component classes will be created when needed
-		m_ComponentClass = null;
-		m_BOSSAClass = null;
-		
-		// Start monitoring for headgear equipment changes
-		// Use staggered polling to distribute load across frames (performance optimization)
-		GetGame().GetCallqueue(CALL_CATEGORY_GAMEPLAY).CallLater(MonitorHeadgearEquipments, 200, true);
-		
-		Print("[VSC Manager] Headgear manager initialized - monitoring for headgear items", LogLevel.NORMAL);
-	}
-	
-	//------------------------------------------------------------------------------------------------
-	// Monitor for headgear being equipped and attach component automatically
-	// Optimized: Only runs on server, processes in batches to avoid frame spikes
-	//------------------------------------------------------------------------------------------------
-	protected void MonitorHeadgearEquipments()
-	{
-		// Only run on server side
-		if (!GetGame().IsServer())
-			return;
-		
-		BaseWorld world = GetGame().GetWorld();
-		if (!world)
-			return;
-		
-		// Performance optimization: Process characters in batches to avoid frame drops
-		// Check all characters but only process a few per frame
-		array<Managed> allCharacters = {};
-		array<Class> excludeClasses = {};
-		array<Object> objects = {};
-		
-		// Search for all characters in the world (optimized search)
-		world.FindEntitiesAround("0 0 0", 50000.0, excludeClasses, allCharacters, objects);
-		
-		int processedThisFrame = 0;
-		const int MAX_PROCESS_PER_FRAME = 8; // Process 8 characters per frame to avoid lag
-		
-		foreach (Managed obj : allCharacters)
+
+		// Headless benchmark mode: replay a recorded input trace (-vscReplay)
+		VSC_ReplayRunner.RunFromCommandLine();
+
+		// Headless test mode: run the autotest suite (-vscTest)
+		VSC_TestRunner.RunFromCommandLine();
+
+		// Server decides the preset before anyone binds a profile
+		if (RplSession.Mode() != RplMode.Client)
 		{
-			IEntity entity = IEntity.Cast(obj);
-			if (!entity)
-				continue;
-			
-			ChimeraCharacter character = ChimeraCharacter.Cast(entity);
-			if (!character)
-				continue;
-			
-			// Limit processing per frame for performance
-			if (processedThisFrame >= MAX_PROCESS_PER_FRAME)
-				break;
-			
-			// Check if character has headgear equipped
-			ProcessCharacterHeadgear(character);
-			processedThisFrame++;
+			ApplyServerPreset();
+			ApplyTelemetry();
 		}
+
+		// Server only - AI hearing is simulated where the AI runs
+		if (m_bEnableAIHearing)
+			VSC_AIHearingSystem.Create(m_bAutoAttach, m_iAIUpdatesPerFrame);
+
+#ifndef VSC_SERVER_LITE
+		// Client only - dedicated servers have no local player to process
+		if (!VSC_LocalController.Create(m_bAutoAttach))
+			return;
+
+#ifndef VSC_NO_LOGGING
+		Print("[VSC Manager] Headgear manager initialized - local controller active", LogLevel.NORMAL);
+#endif
+#endif
 	}
-	
+
 	//------------------------------------------------------------------------------------------------
-	// Process a character's headgear and attach component if needed
+	// Load the configured preset (or the -vscPreset override) and publish it to clients
 	//------------------------------------------------------------------------------------------------
-	protected void ProcessCharacterHeadgear(ChimeraCharacter character)
+	protected void ApplyServerPreset()
 	{
-		if (!character)
-			return;
-		
-		// Get character's inventory
-		InventoryComponent inventory = InventoryComponent.Cast(character.FindComponent(InventoryComponent));
-		if (!inventory)
-			return;
-		
-		// Get headgear - try multiple methods to find it
-		IEntity headgear = null;
-		
-		// Try common headgear slots first (InventorySlots.HEADGEAR varies per project)
-		headgear = inventory.GetItemInSlot(1);
-		if (!headgear)
-			headgear = inventory.GetItemInSlot(2);
-		
-		// Fallback: search inventory for headgear items by name
-		if (!headgear)
-		{
-			headgear = FindHeadgearInInventory(inventory);
-		}
-		
-		if (!headgear)
+		string preset = m_Preset;
+		System.GetCLIParam(CLI_PRESET, preset);
+		if (preset.IsEmpty())
 			return;
-		
-		// Create unique ID for this item
-		string itemID = headgear.GetID().ToString();
-		
-		// Performance: Skip if already processed
-		if (m_mProcessedItems.Contains(itemID) && m_mProcessedItems.Get(itemID))
-			return;
-		
-		if (!m_bAutoAttach)
+
+		if (!VSC_ProfileRegistry.LoadPreset(preset))
 			return;
-		
-		// Attach both components to headgear
-		bool attachedAny = false;
-		attachedAny |= AttachProtection(headgear);
-		attachedAny |= AttachBOSSA(headgear);
-		
-		if (attachedAny)
-		{
-			m_mProcessedItems.Set(itemID, true);
-			Print("[VSC Manager] Attached components to headgear: " + headgear.GetName(), LogLevel.NORMAL);
-		}
+
+		m_sPresetResource = preset;
+		Replication.BumpMe();
 	}
-	
+
 	//------------------------------------------------------------------------------------------------
-	// Find headgear item in character inventory
+	// Start collecting client reports if configured (or -vscTelemetry) and tell clients to send them
 	//------------------------------------------------------------------------------------------------
-	protected IEntity FindHeadgearInInventory(InventoryComponent inventory)
+	protected void ApplyTelemetry()
 	{
-		if (!inventory)
-			return null;
-		
-		// Try to find headgear by checking common inventory slots
-		// Most Arma Reforger headgear is in slot 1 or 2
-		array<int> headgearSlots = {1, 2, 3}; // Common headgear slots
-		
-		foreach (int slot : headgearSlots)
-		{
-			IEntity item = inventory.GetItemInSlot(slot);
-			if (item)
-			{
-				// Check if item name suggests it's headgear (heuristic)
-				string itemName = item.GetName().ToLower();
-				if (itemName.Contains("helmet") || itemName.Contains("cap") || 
-				    itemName.Contains("hat") || itemName.Contains("head") ||
-				    itemName.Contains("headphone") || itemName.Contains("ear") ||
-				    itemName.Contains("headset") || itemName.Contains("comms"))
-				{
-					return item;
-				}
-			}
-		}
-		
-		return null;
+		if (!m_bCollectTelemetry && !System.IsCLIParam(CLI_TELEMETRY))
+			return;
+
+		// Single player has no fleet to hear from
+		if (RplSession.Mode() == RplMode.None)
+			return;
+
+		VSC_TelemetryAggregator.Create();
+		m_bTelemetryActive = true;
+		Replication.BumpMe();
+
+#ifndef VSC_SERVER_LITE
+		// A listen server's host reports like any client
+		VSC_LocalController.SetTelemetryEnabled(true);
+#endif
 	}
-	
+
 	//------------------------------------------------------------------------------------------------
-	// Attach Active Hearing Protection to an item entity
+	// Client: the server's preset arrived (initial state on connect)
 	//------------------------------------------------------------------------------------------------
-	protected bool AttachProtection(IEntity item)
+	protected void OnPresetReplicated()
 	{
-		if (!item)
-			return false;
-		
-		VSC_ActiveHearingProtectionComponent existing = VSC_ActiveHearingProtectionComponent.Cast(item.FindComponent(VSC_ActiveHearingProtectionComponent));
-		if (existing)
-			return true; // Already attached
-		
-		if (!m_ComponentClass)
-		{
-			m_ComponentClass = new VSC_ActiveHearingProtectionComponentClass();
-		}
-		
-		ScriptComponent component = ScriptComponent.Cast(item.CreateComponent(m_ComponentClass));
-		return component != null;
+		if (!VSC_ProfileRegistry.LoadPreset(m_sPresetResource))
+			return;
+
+#ifndef VSC_SERVER_LITE
+		VSC_LocalController.OnTuningChanged();
+#endif
 	}
-	
+
 	//------------------------------------------------------------------------------------------------
-	// Attach BOSSA component to an item entity
+	// Client: whether the server collects telemetry (initial state on connect)
 	//------------------------------------------------------------------------------------------------
-	protected bool AttachBOSSA(IEntity item)
+	protected void OnTelemetryReplicated()
 	{
-		if (!item)
-			return false;
-		
-		VSC_BOSSAComponent existing = VSC_BOSSAComponent.Cast(item.FindComponent(VSC_BOSSAComponent));
-		if (existing)
-			return true; // Already attached
-		
-		if (!m_BOSSAClass)
-		{
-			m_BOSSAClass = new VSC_BOSSAComponentClass();
-		}
-		
-		ScriptComponent component = ScriptComponent.Cast(item.CreateComponent(m_BOSSAClass));
-		return component != null;
+#ifndef VSC_SERVER_LITE
+		VSC_LocalController.SetTelemetryEnabled(m_bTelemetryActive);
+#endif
 	}
-	
+
 	//------------------------------------------------------------------------------------------------
 	override void OnDelete(IEntity owner)
 	{
-		if (m_mProcessedItems)
-		{
-			m_mProcessedItems.Clear();
-		}
-		
-		GetGame().GetCallqueue(CALL_CATEGORY_GAMEPLAY).Remove(MonitorHeadgearEquipments);
-		
+#ifndef VSC_SERVER_LITE
+		VSC_LocalController.SetTelemetryEnabled(false);
+		VSC_LocalController.Destroy();
+#endif
+		VSC_AIHearingSystem.Destroy();
+		VSC_TelemetryAggregator.Destroy();
+		VSC_ProfileRegistry.SetPreset(null);
+
 		super.OnDelete(owner);
 	}
 }
-
@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Hearing Output
+// Final stage of the pipeline: turns the combined gain into an auditory range and writes it
+// only when it changed noticeably. The base class only counts writes (replays and tests).
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+class VSC_HearingOutput
+{
+	// Smaller relative changes are not written (smoothed gains drift in tiny steps)
+	static const float MIN_RELATIVE_CHANGE = 0.01;
+
+	protected float m_fOriginalRange;
+	protected float m_fAppliedRange = -1.0;
+	protected int m_iWriteCount = 0;
+
+	//------------------------------------------------------------------------------------------------
+	void Begin(float originalRange)
+	{
+		m_fOriginalRange = originalRange;
+		m_fAppliedRange = -1.0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Apply(float gain)
+	{
+		float range = m_fOriginalRange * gain;
+		if (m_fAppliedRange >= 0.0 && Math.AbsFloat(range - m_fAppliedRange) <= m_fAppliedRange * MIN_RELATIVE_CHANGE)
+			return;
+
+		Write(range);
+		m_fAppliedRange = range;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Restore the original range for clean deactivation
+	//------------------------------------------------------------------------------------------------
+	void Restore()
+	{
+		Write(m_fOriginalRange);
+		m_fAppliedRange = -1.0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	float GetAppliedRange()
+	{
+		return m_fAppliedRange;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetWriteCount()
+	{
+		return m_iWriteCount;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Write(float range)
+	{
+		m_iWriteCount++;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Writes the auditory range of the local character's PerceptionComponent
+//------------------------------------------------------------------------------------------------
+class VSC_PerceptionOutput : VSC_HearingOutput
+{
+	private PerceptionComponent m_Perception;
+
+	//------------------------------------------------------------------------------------------------
+	void VSC_PerceptionOutput(PerceptionComponent perception)
+	{
+		m_Perception = perception;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override protected void Write(float range)
+	{
+		super.Write(range);
+
+		if (m_Perception)
+			m_Perception.SetAuditoryRange(range);
+	}
+}
@@ -0,0 +1,220 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Input Providers
+// Everything the processors read about the world goes through a VSC_InputProvider, so the same
+// pipeline runs on live world data, on a captured frame while recording, or on a replayed trace.
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------------------------
+// Raw source classification flags (profile independent, recorded in traces)
+// Describe what a source is audibly doing right now - silent entities have no flags
+//------------------------------------------------------------------------------------------------
+enum EVSC_SourceClass
+{
+	CHARACTER = 1,
+	MOVEMENT = 2, // Character moving fast enough for audible footsteps
+	WEAPON = 4, // Fired recently
+	VOICE = 8, // Character transmitting on VoN
+	VEHICLE = 16 // Engine running
+}
+
+//------------------------------------------------------------------------------------------------
+// One sound-producing entity as seen by the pipeline
+//------------------------------------------------------------------------------------------------
+class VSC_SourceSample
+{
+	string m_sId;
+	EntityID m_EntityId = EntityID.INVALID; // Live input only - resolved on refresh, never held as a pointer
+	vector m_vPosition;
+	int m_iClassFlags;
+}
+
+//------------------------------------------------------------------------------------------------
+// One detected shot with its report's signature (see VSC_WeaponSignatures)
+//------------------------------------------------------------------------------------------------
+class VSC_WeaponFire
+{
+	vector m_vPosition;
+	vector m_vDirection; // Muzzle direction, zero if unknown
+	float m_fRangeScale = 1.0; // Trigger range relative to the reference report
+	float m_fDirectivity;
+
+#ifndef VSC_NO_WEAPON_MONITOR
+	//------------------------------------------------------------------------------------------------
+	// Trigger range scale for a listener, lower behind the muzzle of a directional report
+	//------------------------------------------------------------------------------------------------
+	float GetRangeScale(vector listener)
+	{
+		vector toListener = listener - m_vPosition;
+		if (m_fDirectivity <= 0.0 || m_vDirection == vector.Zero || toListener == vector.Zero)
+			return m_fRangeScale;
+
+		float cosAngle = vector.Dot(m_vDirection, toListener.Normalized());
+		float offsetDb = -m_fDirectivity * VSC_WeaponSignatures.DIRECTIVITY_RANGE_DB * (1.0 - cosAngle) * 0.5;
+		return m_fRangeScale * Math.Pow(10.0, offsetDb / 20.0);
+	}
+#endif
+}
+
+//------------------------------------------------------------------------------------------------
+// All inputs for one processing tick
+//------------------------------------------------------------------------------------------------
+class VSC_InputFrame
+{
+	float m_fTime;
+	vector m_vListenerOrigin;
+	vector m_vListenerForward;
+	ref VSC_Acoustics m_Acoustics = new VSC_Acoustics();
+	ref array<ref VSC_SourceSample> m_aSources = {};
+	ref array<ref VSC_WeaponFire> m_aWeaponFire = {};
+	ref array<vector> m_aExplosions = {};
+	ref array<float> m_aExplosionTimes = {}; // World ms each explosion went off, matching m_aExplosions
+
+	//------------------------------------------------------------------------------------------------
+	void Clear()
+	{
+		m_aSources.Clear();
+		m_aWeaponFire.Clear();
+		m_aExplosions.Clear();
+		m_aExplosionTimes.Clear();
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Base input provider - override in concrete inputs
+//------------------------------------------------------------------------------------------------
+class VSC_InputProvider
+{
+	protected static ref VSC_Acoustics s_OpenTerrain = new VSC_Acoustics();
+
+	//------------------------------------------------------------------------------------------------
+	// Current world time in milliseconds (read through the pipeline's VSC_Clock)
+	//------------------------------------------------------------------------------------------------
+	float GetTime()
+	{
+		return 0.0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	vector GetListenerOrigin()
+	{
+		return vector.Zero;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	vector GetListenerForward()
+	{
+		return "0 0 1";
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Acoustic environment of the listener this tick - do not modify
+	//------------------------------------------------------------------------------------------------
+	VSC_Acoustics GetListenerAcoustics()
+	{
+		return s_OpenTerrain;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Currently audible sources inside one discovery sweep region (see VSC_DiscoverySweep)
+	//------------------------------------------------------------------------------------------------
+	void QueryRegion(VSC_SweepRegion region, notnull array<ref VSC_SourceSample> outSamples)
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Current position and classification of an already tracked source, false if it is gone or silent
+	//------------------------------------------------------------------------------------------------
+	bool GetSourceState(VSC_TrackedSoundSource source, out vector position, out int classFlags)
+	{
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Shots fired within range since the last tick
+	//------------------------------------------------------------------------------------------------
+	void CollectWeaponFire(float range, notnull array<ref VSC_WeaponFire> outFire)
+	{
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Serves a single VSC_InputFrame - used while recording and when replaying traces
+//------------------------------------------------------------------------------------------------
+class VSC_FrameInput : VSC_InputProvider
+{
+	private VSC_InputFrame m_Frame;
+	private ref map<string, VSC_SourceSample> m_mSourcesById = new map<string, VSC_SourceSample>();
+
+	//------------------------------------------------------------------------------------------------
+	void SetFrame(VSC_InputFrame frame)
+	{
+		m_Frame = frame;
+
+		m_mSourcesById.Clear();
+		foreach (VSC_SourceSample sample : frame.m_aSources)
+		{
+			m_mSourcesById.Set(sample.m_sId, sample);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override float GetTime()
+	{
+		return m_Frame.m_fTime;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override vector GetListenerOrigin()
+	{
+		return m_Frame.m_vListenerOrigin;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override vector GetListenerForward()
+	{
+		return m_Frame.m_vListenerForward;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override VSC_Acoustics GetListenerAcoustics()
+	{
+		return m_Frame.m_Acoustics;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void QueryRegion(VSC_SweepRegion region, notnull array<ref VSC_SourceSample> outSamples)
+	{
+		// Same query sphere as the live input, so vertical limits match in replays
+		vector center = region.GetCenter();
+		float radiusSq = region.m_fQueryRadius * region.m_fQueryRadius;
+		foreach (VSC_SourceSample sample : m_Frame.m_aSources)
+		{
+			if (sample.m_iClassFlags != 0 && vector.DistanceSq(center, sample.m_vPosition) <= radiusSq && region.Contains(sample.m_vPosition))
+				outSamples.Insert(sample);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override bool GetSourceState(VSC_TrackedSoundSource source, out vector position, out int classFlags)
+	{
+		VSC_SourceSample sample;
+		if (!m_mSourcesById.Find(source.m_sId, sample) || sample.m_iClassFlags == 0)
+			return false;
+
+		position = sample.m_vPosition;
+		classFlags = sample.m_iClassFlags;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void CollectWeaponFire(float range, notnull array<ref VSC_WeaponFire> outFire)
+	{
+		float rangeSq = range * range;
+		foreach (VSC_WeaponFire fire : m_Frame.m_aWeaponFire)
+		{
+			if (vector.DistanceSq(m_Frame.m_vListenerOrigin, fire.m_vPosition) < rangeSq)
+				outFire.Insert(fire);
+		}
+	}
+}
@@ -0,0 +1,100 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Learning Store
+// Keeps the player's adaptive-learning state across lives and sessions. The client loads it
+// once, BOSSA updates it in memory, and it is written back at most every SAVE_INTERVAL_MS
+// and on unbind. All values are 4-byte ints/floats. The store is not compiled with
+// VSC_NO_ADAPTIVE_LEARNING; VSC_LearnedState stays so the pipeline API is the same in every build.
+//
+// Layout: MAGIC, VERSION, attention angle, enhancement level, update count
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------------------------
+// Learned BOSSA parameters, shared between the store and the active processor
+//------------------------------------------------------------------------------------------------
+class VSC_LearnedState
+{
+	bool m_bValid; // False until loaded or learned once - processors then start from the profile
+	float m_fAttentionAngle;
+	float m_fEnhancementLevel;
+	int m_iUpdateCount; // Total learning steps, also the dirty marker for saving
+}
+
+#ifndef VSC_NO_ADAPTIVE_LEARNING
+//------------------------------------------------------------------------------------------------
+class VSC_LearningStore
+{
+	static const int MAGIC = 0x4C435356; // "VSCL"
+	static const int VERSION = 1;
+	static const string PATH = "$profile:VSC/learning.bin";
+	static const int SAVE_INTERVAL_MS = 30000;
+
+	private ref VSC_LearnedState m_State = new VSC_LearnedState();
+	private int m_iSavedUpdateCount;
+
+	//------------------------------------------------------------------------------------------------
+	VSC_LearnedState GetState()
+	{
+		return m_State;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Restore the saved state, false if there is none or it has an unknown version
+	//------------------------------------------------------------------------------------------------
+	bool Load()
+	{
+		if (!FileIO.FileExists(PATH))
+			return false;
+
+		FileHandle file = FileIO.OpenFile(PATH, FileMode.READ);
+		if (!file)
+			return false;
+
+		int magic, version, updateCount;
+		float angle, level;
+		bool ok = file.Read(magic, 4) == 4 && magic == MAGIC && file.Read(version, 4) == 4 && version == VERSION;
+		ok = ok && file.Read(angle, 4) == 4 && file.Read(level, 4) == 4 && file.Read(updateCount, 4) == 4;
+		file.Close();
+
+		if (!ok)
+		{
+			Print("[VSC] Ignoring unsupported learning state: " + PATH, LogLevel.WARNING);
+			return false;
+		}
+
+		m_State.m_bValid = true;
+		m_State.m_fAttentionAngle = angle;
+		m_State.m_fEnhancementLevel = level;
+		m_State.m_iUpdateCount = updateCount;
+		m_iSavedUpdateCount = updateCount;
+
+#ifndef VSC_NO_LOGGING
+		Print("[VSC] Restored learned attention angle: " + angle + " degrees", LogLevel.NORMAL);
+#endif
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Write the state if it was updated since the last save
+	//------------------------------------------------------------------------------------------------
+	void SaveIfChanged()
+	{
+		if (!m_State.m_bValid || m_State.m_iUpdateCount == m_iSavedUpdateCount)
+			return;
+
+		FileIO.MakeDirectory(VSC_Trace.DIRECTORY);
+		FileHandle file = FileIO.OpenFile(PATH, FileMode.WRITE);
+		if (!file)
+			return;
+
+		file.Write(MAGIC, 4);
+		file.Write(VERSION, 4);
+		file.Write(m_State.m_fAttentionAngle, 4);
+		file.Write(m_State.m_fEnhancementLevel, 4);
+		file.Write(m_State.m_iUpdateCount, 4);
+		file.Close();
+
+		m_iSavedUpdateCount = m_State.m_iUpdateCount;
+	}
+}
+#endif
@@ -0,0 +1,904 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Local Controller
+// Client-side singleton bound to the locally controlled character. Runs hearing protection and
+// BOSSA for that character only; equipped headgear is a capability flag and profile lookup.
+// Driven by possession changes (SCR_PlayerController) and the character's inventory events.
+// Processing is parked while the listener can't meaningfully hear (dead, unconscious, in a
+// menu or on the map), following life-state, menu and map events.
+// Not compiled with VSC_SERVER_LITE.
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+#ifndef VSC_SERVER_LITE
+class VSC_LocalController
+{
+	private static ref VSC_LocalController s_Instance;
+
+	static const int DEFAULT_TICK_INTERVAL_MS = 50;
+	private const int MIN_TICK_INTERVAL_MS = 10;
+
+	// Launch parameter: -vscRecord <name> writes an input trace to $profile:VSC/<name>.vsctrace
+	static const string CLI_RECORD = "vscRecord";
+
+	// Headgear without VSC components qualifies when the manager's auto-attach toggle is on
+	private bool m_bAutoAttach;
+
+	// Controlled character and the inventory and controller whose events we follow
+	private ChimeraCharacter m_ControlledCharacter;
+	private SCR_InventoryStorageManagerComponent m_Inventory;
+	private SCR_CharacterControllerComponent m_CharacterController;
+
+	// Character and headgear the pipeline is attached to
+	private ChimeraCharacter m_Character;
+	private IEntity m_Headgear;
+	private PerceptionComponent m_Perception;
+	private float m_fOriginalAuditoryRange;
+
+	// Suspension: bound, but the pipeline is detached and nothing is scheduled
+	private bool m_bSuspended;
+	private bool m_bMapOpen;
+	private int m_iOpenMenus; // Open menus that block hearing (see BlocksHearing)
+
+	private ref VSC_WorldInput m_WorldInput;
+	private ref VSC_Pipeline m_Pipeline;
+
+	// Recording: processors read the captured frame so the trace holds exactly what they saw
+	private ref VSC_TraceRecorder m_Recorder;
+	private ref VSC_FrameInput m_FrameInput;
+	private string m_sRecordName;
+
+#ifndef VSC_NO_ADAPTIVE_LEARNING
+	// Adaptive learning survives respawns and helmet swaps, saved with throttled writes
+	private ref VSC_LearningStore m_LearningStore;
+#endif
+
+	// Runtime tuning (see VSC_Tuning): edits collect on private profile copies and are swapped in
+	// together at the start of the next frame. Tuned profiles replace the headgear profiles.
+	private ref VSC_ProtectionProfile m_TunedProtection;
+	private ref VSC_BOSSAProfile m_TunedBOSSA;
+	private ref VSC_ProtectionProfile m_PendingProtection;
+	private ref VSC_BOSSAProfile m_PendingBOSSA;
+	private int m_iTickIntervalMs = DEFAULT_TICK_INTERVAL_MS;
+	private int m_iPendingTickIntervalMs = DEFAULT_TICK_INTERVAL_MS;
+	private bool m_bTuningPending;
+	private bool m_bTuningReset;
+
+	// Measured stage cost, reset whenever tuning changes
+	private ref VSC_StageStats m_Stats = new VSC_StageStats();
+
+	// Fleet telemetry (see VSC_Telemetry), switched on by the server
+	private static bool s_bTelemetryEnabled;
+	private ref VSC_TelemetrySampler m_Telemetry = new VSC_TelemetrySampler();
+
+#ifdef ENABLE_DIAG
+	// Per-frame overlay drawing is scheduled only while the DiagMenu toggle is on
+	private bool m_bOverlayShown;
+#endif
+
+	//------------------------------------------------------------------------------------------------
+	// Create the client singleton (no-op on dedicated servers)
+	//------------------------------------------------------------------------------------------------
+	static VSC_LocalController Create(bool autoAttach)
+	{
+		if (RplSession.Mode() == RplMode.Dedicated)
+			return null;
+
+		if (!s_Instance)
+		{
+			s_Instance = new VSC_LocalController();
+			s_Instance.Start(autoAttach);
+		}
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static VSC_LocalController GetInstance()
+	{
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static void Destroy()
+	{
+		if (!s_Instance)
+			return;
+
+		s_Instance.Stop();
+		s_Instance = null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Tuning profiles were replaced (server preset) - rebuild the pipeline with the new ones
+	//------------------------------------------------------------------------------------------------
+	static void OnTuningChanged()
+	{
+		if (!s_Instance)
+			return;
+
+		s_Instance.Unbind();
+		s_Instance.Refresh();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// The server collects telemetry (replicated on connect), start or stop sending reports
+	//------------------------------------------------------------------------------------------------
+	static void SetTelemetryEnabled(bool enabled)
+	{
+		s_bTelemetryEnabled = enabled;
+		if (s_Instance)
+			s_Instance.ScheduleTelemetry();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Start(bool autoAttach)
+	{
+		m_bAutoAttach = autoAttach;
+		m_WorldInput = new VSC_WorldInput();
+#ifndef VSC_NO_ADAPTIVE_LEARNING
+		m_LearningStore = new VSC_LearningStore();
+		m_LearningStore.Load();
+#endif
+
+		System.GetCLIParam(CLI_RECORD, m_sRecordName);
+
+#ifdef ENABLE_DIAG
+		VSC_DebugOverlay.Register();
+#endif
+
+#ifndef VSC_NO_ADAPTIVE_LEARNING
+		GetGame().GetCallqueue(CALL_CATEGORY_GAMEPLAY).CallLater(m_LearningStore.SaveIfChanged, VSC_LearningStore.SAVE_INTERVAL_MS, true);
+#endif
+
+		SCR_MapEntity.GetOnMapOpen().Insert(OnMapOpen);
+		SCR_MapEntity.GetOnMapClose().Insert(OnMapClose);
+		SCR_MenuHelper.GetOnMenuOpen().Insert(OnMenuOpen);
+		SCR_MenuHelper.GetOnMenuClose().Insert(OnMenuClose);
+
+		ScheduleTelemetry();
+
+		// Later possession changes arrive through SCR_PlayerController, pick up the current one now
+		PlayerController playerController = GetGame().GetPlayerController();
+		if (playerController)
+			SetControlledCharacter(ChimeraCharacter.Cast(playerController.GetControlledEntity()));
+
+#ifndef VSC_NO_LOGGING
+		Print("[VSC] Local controller started", LogLevel.NORMAL);
+#endif
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Stop()
+	{
+#ifndef VSC_NO_ADAPTIVE_LEARNING
+		GetGame().GetCallqueue(CALL_CATEGORY_GAMEPLAY).Remove(m_LearningStore.SaveIfChanged);
+#endif
+		GetGame().GetCallqueue(CALL_CATEGORY_GAMEPLAY).Remove(SendTelemetry);
+
+		SCR_MapEntity.GetOnMapOpen().Remove(OnMapOpen);
+		SCR_MapEntity.GetOnMapClose().Remove(OnMapClose);
+		SCR_MenuHelper.GetOnMenuOpen().Remove(OnMenuOpen);
+		SCR_MenuHelper.GetOnMenuClose().Remove(OnMenuClose);
+
+		SetControlledCharacter(null);
+		Unbind();
+
+		if (m_Recorder)
+			m_Recorder.Stop();
+
+		m_Recorder = null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Called by the local SCR_PlayerController when it takes control of another entity
+	//------------------------------------------------------------------------------------------------
+	void OnControlledEntityChanged(IEntity entity)
+	{
+		SetControlledCharacter(ChimeraCharacter.Cast(entity));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Follow a newly controlled character and its inventory events
+	//------------------------------------------------------------------------------------------------
+	protected void SetControlledCharacter(ChimeraCharacter character)
+	{
+		if (character == m_ControlledCharacter)
+			return;
+
+		if (m_Inventory)
+		{
+			m_Inventory.m_OnItemAddedInvoker.Remove(OnInventoryChanged);
+			m_Inventory.m_OnItemRemovedInvoker.Remove(OnInventoryChanged);
+		}
+
+		if (m_CharacterController)
+			m_CharacterController.m_OnLifeStateChanged.Remove(OnLifeStateChanged);
+
+		m_ControlledCharacter = character;
+		m_Inventory = null;
+		m_CharacterController = null;
+
+		if (character)
+		{
+			m_Inventory = SCR_InventoryStorageManagerComponent.Cast(character.FindComponent(SCR_InventoryStorageManagerComponent));
+			if (m_Inventory)
+			{
+				m_Inventory.m_OnItemAddedInvoker.Insert(OnInventoryChanged);
+				m_Inventory.m_OnItemRemovedInvoker.Insert(OnInventoryChanged);
+			}
+
+			m_CharacterController = SCR_CharacterControllerComponent.Cast(character.GetCharacterController());
+			if (m_CharacterController)
+				m_CharacterController.m_OnLifeStateChanged.Insert(OnLifeStateChanged);
+		}
+
+		// Bind in the same frame control is taken, no warmup
+		Refresh();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Equip or unequip on the controlled character
+	//------------------------------------------------------------------------------------------------
+	protected void OnInventoryChanged(IEntity item, BaseInventoryStorageComponent storageOwner)
+	{
+		Refresh();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Death, unconsciousness and revival of the controlled character
+	//------------------------------------------------------------------------------------------------
+	protected void OnLifeStateChanged(ECharacterLifeState previousLifeState, ECharacterLifeState newLifeState)
+	{
+		UpdateSuspension();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void OnMapOpen(MapConfiguration config)
+	{
+		m_bMapOpen = true;
+		UpdateSuspension();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void OnMapClose(MapConfiguration config)
+	{
+		m_bMapOpen = false;
+		UpdateSuspension();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void OnMenuOpen(ChimeraMenuBase menu)
+	{
+		if (!BlocksHearing(menu))
+			return;
+
+		m_iOpenMenus++;
+		UpdateSuspension();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void OnMenuClose(ChimeraMenuBase menu)
+	{
+		if (!BlocksHearing(menu))
+			return;
+
+		m_iOpenMenus = Math.Max(m_iOpenMenus - 1, 0);
+		UpdateSuspension();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Full-screen menus (deploy, pause, settings) - the inventory is used in the field and keeps hearing
+	//------------------------------------------------------------------------------------------------
+	protected bool BlocksHearing(ChimeraMenuBase menu)
+	{
+		return menu && !SCR_InventoryMenuUI.Cast(menu);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Whether the bound listener currently can't meaningfully hear
+	//------------------------------------------------------------------------------------------------
+	protected bool ShouldSuspend()
+	{
+		if (m_bMapOpen || m_iOpenMenus > 0)
+			return true;
+
+		CharacterControllerComponent controller = m_Character.GetCharacterController();
+		return controller && controller.GetLifeState() != ECharacterLifeState.ALIVE;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Park or resume processing of the bound character
+	//------------------------------------------------------------------------------------------------
+	protected void UpdateSuspension()
+	{
+		if (!m_Character || !m_Pipeline)
+			return;
+
+		bool suspend = ShouldSuspend();
+		if (suspend == m_bSuspended)
+			return;
+
+		m_bSuspended = suspend;
+		if (suspend)
+		{
+			// Restore normal hearing and stop everything, tracked state is kept for the resume
+			StopProcessing();
+			m_Pipeline.Detach();
+#ifndef VSC_NO_ADAPTIVE_LEARNING
+			m_LearningStore.SaveIfChanged();
+#endif
+#ifndef VSC_NO_LOGGING
+			Print("[VSC] Processing suspended", LogLevel.NORMAL);
+#endif
+			return;
+		}
+
+		// Re-validate everything at once and run a short fast-refresh burst (see BOSSA Retarget)
+		if (m_Recorder)
+			m_FrameInput.SetFrame(m_Recorder.CaptureFrame(m_WorldInput));
+
+		m_Pipeline.Attach(new VSC_PerceptionOutput(m_Perception), m_fOriginalAuditoryRange);
+		StartProcessing();
+#ifndef VSC_NO_LOGGING
+		Print("[VSC] Processing resumed", LogLevel.NORMAL);
+#endif
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Attach to the controlled character if it wears qualifying headgear, detach otherwise
+	//------------------------------------------------------------------------------------------------
+	protected void Refresh()
+	{
+		IEntity headgear;
+		PerceptionComponent perception;
+		if (m_ControlledCharacter)
+		{
+			headgear = VSC_Headgear.FindQualifyingHeadgear(m_ControlledCharacter, m_bAutoAttach);
+			perception = PerceptionComponent.Cast(m_ControlledCharacter.FindComponent(PerceptionComponent));
+		}
+
+		if (!headgear || !perception)
+		{
+			Detach();
+			return;
+		}
+
+		if (m_ControlledCharacter == m_Character && headgear == m_Headgear)
+			return;
+
+		Detach();
+		Bind(m_ControlledCharacter, headgear, perception);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Start processing for a character wearing qualifying headgear, continuing the previous
+	// pipeline (tracked sources, dampening, smoothing) when the tuning profiles are the same
+	//------------------------------------------------------------------------------------------------
+	protected void Bind(ChimeraCharacter character, IEntity headgear, PerceptionComponent perception)
+	{
+		// Different tuning - start from scratch
+		VSC_ProtectionProfile protectionProfile = FindProtectionProfile(headgear);
+		VSC_BOSSAProfile bossaProfile = FindBOSSAProfile(headgear);
+		if (m_Pipeline && !m_Pipeline.UsesProfiles(protectionProfile, bossaProfile))
+			Unbind();
+
+		m_Character = character;
+		m_Headgear = headgear;
+		m_Perception = perception;
+
+		// Store original hearing range for clean restoration
+		m_fOriginalAuditoryRange = perception.GetAuditoryRange();
+
+		m_WorldInput.SetListener(character);
+
+		if (m_Pipeline)
+		{
+			if (m_Recorder)
+				m_FrameInput.SetFrame(m_Recorder.CaptureFrame(m_WorldInput));
+
+			m_Pipeline.Attach(new VSC_PerceptionOutput(perception), m_fOriginalAuditoryRange);
+		}
+		else
+		{
+			VSC_InputProvider input = m_WorldInput;
+			if (StartRecording())
+			{
+				m_FrameInput.SetFrame(m_Recorder.CaptureFrame(m_WorldInput));
+				input = m_FrameInput;
+			}
+
+			m_Pipeline = new VSC_Pipeline(input, protectionProfile, bossaProfile, new VSC_PerceptionOutput(perception));
+			m_Pipeline.SetAudioOutput(new VSC_MasterVolumeOutput());
+			m_Pipeline.SetStageStats(m_Stats);
+#ifndef VSC_NO_ADAPTIVE_LEARNING
+			m_Pipeline.SetLearnedState(m_LearningStore.GetState());
+#endif
+			m_Pipeline.Activate(m_fOriginalAuditoryRange);
+		}
+
+		StartProcessing();
+
+#ifndef VSC_NO_LOGGING
+		Print("[VSC] Bound to local character, headgear: " + headgear.GetName(), LogLevel.NORMAL);
+#endif
+
+		// Spawned while still in a menu or on the map
+		UpdateSuspension();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Restore the character's hearing and stop ticking, keeping the pipeline for the next bind
+	//------------------------------------------------------------------------------------------------
+	protected void Detach()
+	{
+		StopProcessing();
+
+		// Restore the player's hearing to its original state
+		if (m_Pipeline)
+			m_Pipeline.Detach();
+
+#ifndef VSC_NO_ADAPTIVE_LEARNING
+		// End of a life or headgear swap - keep what was learned
+		if (m_Character)
+			m_LearningStore.SaveIfChanged();
+#endif
+
+		m_Character = null;
+		m_Headgear = null;
+		m_Perception = null;
+		m_bSuspended = false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Start the shared tick, explosion and entity deletion events
+	//------------------------------------------------------------------------------------------------
+	protected void StartProcessing()
+	{
+		// Subscribe to the global explosion event
+		// Performance: Event-driven, no polling overhead
+		BaseWorld world = GetGame().GetWorld();
+		if (world)
+			world.GetOnExplosion().Insert(OnExplosion);
+
+		VSC_EntityEvents.GetOnDeleted().Insert(OnEntityDeleted);
+
+		GetGame().GetCallqueue(CALL_CATEGORY_GAMEPLAY).CallLater(Tick, m_iTickIntervalMs, true);
+		GetGame().GetCallqueue(CALL_CATEGORY_GAMEPLAY).CallLater(AudioFrame, 0, true);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void StopProcessing()
+	{
+		GetGame().GetCallqueue(CALL_CATEGORY_GAMEPLAY).Remove(Tick);
+		GetGame().GetCallqueue(CALL_CATEGORY_GAMEPLAY).Remove(AudioFrame);
+
+#ifdef ENABLE_DIAG
+		ShowOverlay(false);
+#endif
+
+		// Unsubscribe from the global events to prevent memory leaks and errors
+		BaseWorld world = GetGame().GetWorld();
+		if (world)
+			world.GetOnExplosion().Remove(OnExplosion);
+
+		VSC_EntityEvents.GetOnDeleted().Remove(OnEntityDeleted);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Stop processing and drop all pipeline state
+	//------------------------------------------------------------------------------------------------
+	protected void Unbind()
+	{
+		Detach();
+
+		if (m_Pipeline)
+			m_Pipeline.Deactivate();
+
+		m_Pipeline = null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Shared processing tick for all stages
+	//------------------------------------------------------------------------------------------------
+	protected void Tick()
+	{
+		if (!m_Pipeline)
+			return;
+
+		m_WorldInput.BeginFrame();
+
+		if (m_Recorder)
+			m_FrameInput.SetFrame(m_Recorder.CaptureFrame(m_WorldInput));
+
+		m_Pipeline.Update();
+
+		if (s_bTelemetryEnabled)
+			m_Telemetry.Sample(m_Pipeline, m_Stats);
+
+#ifdef ENABLE_DIAG
+		ShowOverlay(VSC_DebugOverlay.IsEnabled());
+		VSC_DebugOverlay.PollTuning(this);
+#endif
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Per-frame release of the audio output (attenuation is applied as soon as it is computed)
+	//------------------------------------------------------------------------------------------------
+	protected void AudioFrame()
+	{
+		ApplyPendingTuning();
+
+		if (m_Pipeline)
+			m_Pipeline.UpdateAudio(m_WorldInput.GetTime());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// (Re)start the report interval and schedule the next report while telemetry is on
+	//------------------------------------------------------------------------------------------------
+	protected void ScheduleTelemetry()
+	{
+		GetGame().GetCallqueue(CALL_CATEGORY_GAMEPLAY).Remove(SendTelemetry);
+		if (!s_bTelemetryEnabled)
+			return;
+
+		m_Telemetry.Begin(m_Stats, VSC_Clock.SampleWorld().GetMs());
+		GetGame().GetCallqueue(CALL_CATEGORY_GAMEPLAY).CallLater(SendTelemetry, VSC_TelemetrySampler.GetNextReportDelay(), false);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Send the interval's summary through the local player controller and schedule the next one
+	//------------------------------------------------------------------------------------------------
+	protected void SendTelemetry()
+	{
+		VSC_TelemetryReport report = m_Telemetry.TakeReport(m_Stats, VSC_Clock.SampleWorld().GetMs());
+
+		// Intervals spent suspended or unbound have nothing to say
+		SCR_PlayerController playerController = SCR_PlayerController.Cast(GetGame().GetPlayerController());
+		if (playerController && report.m_iTicks > 0)
+			playerController.VSC_SendTelemetry(report.Encode());
+
+		GetGame().GetCallqueue(CALL_CATEGORY_GAMEPLAY).CallLater(SendTelemetry, VSC_TelemetrySampler.GetNextReportDelay(), false);
+	}
+
+#ifdef ENABLE_DIAG
+	//------------------------------------------------------------------------------------------------
+	// Start or stop the per-frame overlay draw
+	//------------------------------------------------------------------------------------------------
+	protected void ShowOverlay(bool show)
+	{
+		if (show == m_bOverlayShown)
+			return;
+
+		m_bOverlayShown = show;
+		if (show)
+			GetGame().GetCallqueue(CALL_CATEGORY_GAMEPLAY).CallLater(DrawOverlay, 0, true);
+		else
+			GetGame().GetCallqueue(CALL_CATEGORY_GAMEPLAY).Remove(DrawOverlay);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void DrawOverlay()
+	{
+		VSC_DebugOverlay.Draw(m_Pipeline, m_Stats, m_WorldInput.GetListenerOrigin(), m_WorldInput.GetListenerForward());
+	}
+#endif
+
+	//------------------------------------------------------------------------------------------------
+	// This method is called by the game engine whenever ANY explosion happens in the world
+	//------------------------------------------------------------------------------------------------
+	protected void OnExplosion(IEntity explosionEntity, IEntity source, vector position, float rawDamage, float range, EExplosionType type)
+	{
+		// Handled at the current world time, which the trace keeps for replays
+		float time = m_WorldInput.GetTime();
+		if (m_Recorder)
+			m_Recorder.AddExplosion(position, time);
+
+		if (m_Pipeline)
+			m_Pipeline.HandleExplosion(position, time);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// A character or vehicle left the world - tracked sources must not outlive it
+	//------------------------------------------------------------------------------------------------
+	protected void OnEntityDeleted(IEntity entity)
+	{
+		if (m_Pipeline)
+			m_Pipeline.OnSourceDeleted(entity.GetID().ToString());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Open the input trace on first bind when launched with -vscRecord
+	//------------------------------------------------------------------------------------------------
+	protected bool StartRecording()
+	{
+		if (m_sRecordName.IsEmpty())
+			return false;
+
+		if (!m_Recorder)
+		{
+			VSC_TraceRecorder recorder = new VSC_TraceRecorder();
+			if (!recorder.Start(m_sRecordName, m_fOriginalAuditoryRange))
+			{
+				m_sRecordName = string.Empty;
+				return false;
+			}
+
+			m_Recorder = recorder;
+			m_FrameInput = new VSC_FrameInput();
+		}
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	ChimeraCharacter GetCharacter()
+	{
+		return m_Character;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected VSC_ProtectionProfile FindProtectionProfile(IEntity headgear)
+	{
+		VSC_ProtectionProfile profile = VSC_Headgear.GetProtectionProfile(headgear);
+		if (!profile && m_bAutoAttach)
+			profile = VSC_ProfileRegistry.GetProtectionProfile(string.Empty);
+
+		// Runtime tuning applies to whichever stages the headgear enables
+		if (profile && m_TunedProtection)
+			return m_TunedProtection;
+
+		return profile;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected VSC_BOSSAProfile FindBOSSAProfile(IEntity headgear)
+	{
+		VSC_BOSSAProfile profile = VSC_Headgear.GetBOSSAProfile(headgear);
+		if (!profile && m_bAutoAttach)
+			profile = VSC_ProfileRegistry.GetBOSSAProfile(string.Empty);
+
+		if (profile && m_TunedBOSSA)
+			return m_TunedBOSSA;
+
+		return profile;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Tuning parameter keys: protection.<name>, bossa.<name> and controller.TickIntervalMs
+	//------------------------------------------------------------------------------------------------
+	void GetParameterKeys(notnull array<string> outKeys)
+	{
+		array<string> parameters = {};
+		VSC_Tuning.GetParameters(GetTuningProtection(), parameters);
+		foreach (string parameter : parameters)
+		{
+			outKeys.Insert("protection." + parameter);
+		}
+
+		parameters.Clear();
+		VSC_Tuning.GetParameters(GetTuningBOSSA(), parameters);
+		foreach (string parameter : parameters)
+		{
+			outKeys.Insert("bossa." + parameter);
+		}
+
+		outKeys.Insert("controller.TickIntervalMs");
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Current value of a parameter including edits not applied yet, empty if unknown
+	//------------------------------------------------------------------------------------------------
+	string GetParameter(string key)
+	{
+		string group, parameter;
+		if (!SplitParameterKey(key, group, parameter))
+			return string.Empty;
+
+		switch (group)
+		{
+			case "protection":
+				return VSC_Tuning.Get(GetTuningProtection(), parameter);
+
+			case "bossa":
+				return VSC_Tuning.Get(GetTuningBOSSA(), parameter);
+
+			case "controller":
+			{
+				if (parameter == "tickintervalms")
+					return m_iPendingTickIntervalMs.ToString();
+
+				break;
+			}
+		}
+
+		return string.Empty;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Edit a parameter, applied with all other edits at the start of the next frame
+	//------------------------------------------------------------------------------------------------
+	bool SetParameter(string key, string value)
+	{
+		string group, parameter;
+		if (!SplitParameterKey(key, group, parameter))
+			return false;
+
+		bool changed;
+		switch (group)
+		{
+			case "protection":
+			{
+				if (!m_PendingProtection)
+				{
+					m_PendingProtection = new VSC_ProtectionProfile();
+					VSC_Tuning.Copy(GetTuningProtection(), m_PendingProtection);
+				}
+
+				changed = VSC_Tuning.Set(m_PendingProtection, parameter, value);
+				break;
+			}
+
+			case "bossa":
+			{
+				if (!m_PendingBOSSA)
+				{
+					m_PendingBOSSA = new VSC_BOSSAProfile();
+					VSC_Tuning.Copy(GetTuningBOSSA(), m_PendingBOSSA);
+				}
+
+				changed = VSC_Tuning.Set(m_PendingBOSSA, parameter, value);
+				break;
+			}
+
+			case "controller":
+			{
+				if (parameter == "tickintervalms")
+				{
+					m_iPendingTickIntervalMs = Math.Max(value.ToInt(), MIN_TICK_INTERVAL_MS);
+					changed = true;
+				}
+
+				break;
+			}
+		}
+
+		if (changed)
+			m_bTuningPending = true;
+
+		return changed;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Drop all runtime tuning on the next frame
+	//------------------------------------------------------------------------------------------------
+	void ResetTuning()
+	{
+		m_PendingProtection = null;
+		m_PendingBOSSA = null;
+		m_iPendingTickIntervalMs = DEFAULT_TICK_INTERVAL_MS;
+		m_bTuningReset = true;
+		m_bTuningPending = true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Stage cost measured since the last tuning change
+	//------------------------------------------------------------------------------------------------
+	VSC_StageStats GetStageStats()
+	{
+		return m_Stats;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Swap in all pending edits at once, keeping tracked sources and dampening state
+	//------------------------------------------------------------------------------------------------
+	protected void ApplyPendingTuning()
+	{
+		if (!m_bTuningPending)
+			return;
+
+		m_bTuningPending = false;
+		if (m_bTuningReset)
+		{
+			m_TunedProtection = null;
+			m_TunedBOSSA = null;
+			m_bTuningReset = false;
+		}
+
+		if (m_PendingProtection)
+			m_TunedProtection = m_PendingProtection;
+
+		if (m_PendingBOSSA)
+			m_TunedBOSSA = m_PendingBOSSA;
+
+		m_PendingProtection = null;
+		m_PendingBOSSA = null;
+
+		if (m_Pipeline && m_Headgear)
+			m_Pipeline.SetProfiles(FindProtectionProfile(m_Headgear), FindBOSSAProfile(m_Headgear));
+
+		// Only called from the per-frame callback, so the tick is scheduled
+		if (m_iPendingTickIntervalMs != m_iTickIntervalMs)
+		{
+			m_iTickIntervalMs = m_iPendingTickIntervalMs;
+			GetGame().GetCallqueue(CALL_CATEGORY_GAMEPLAY).Remove(Tick);
+			GetGame().GetCallqueue(CALL_CATEGORY_GAMEPLAY).CallLater(Tick, m_iTickIntervalMs, true);
+		}
+
+		m_Stats.Reset();
+		m_Telemetry.OnStatsReset();
+#ifndef VSC_NO_LOGGING
+		Print("[VSC] Runtime tuning applied", LogLevel.NORMAL);
+#endif
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Profiles edits start from: pending edits, then the active tuning, then the defaults
+	//------------------------------------------------------------------------------------------------
+	protected VSC_ProtectionProfile GetTuningProtection()
+	{
+		if (m_PendingProtection)
+			return m_PendingProtection;
+
+		// After a reset, edits start over from the headgear's own profile
+		if (!m_bTuningReset)
+		{
+			if (m_Pipeline && m_Pipeline.GetProtectionProfile())
+				return m_Pipeline.GetProtectionProfile();
+
+			if (m_TunedProtection)
+				return m_TunedProtection;
+		}
+
+		if (m_Headgear)
+		{
+			VSC_ProtectionProfile profile = VSC_Headgear.GetProtectionProfile(m_Headgear);
+			if (profile)
+				return profile;
+		}
+
+		return VSC_ProfileRegistry.GetProtectionProfile(string.Empty);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected VSC_BOSSAProfile GetTuningBOSSA()
+	{
+		if (m_PendingBOSSA)
+			return m_PendingBOSSA;
+
+		// After a reset, edits start over from the headgear's own profile
+		if (!m_bTuningReset)
+		{
+			if (m_Pipeline && m_Pipeline.GetBOSSAProfile())
+				return m_Pipeline.GetBOSSAProfile();
+
+			if (m_TunedBOSSA)
+				return m_TunedBOSSA;
+		}
+
+		if (m_Headgear)
+		{
+			VSC_BOSSAProfile profile = VSC_Headgear.GetBOSSAProfile(m_Headgear);
+			if (profile)
+				return profile;
+		}
+
+		return VSC_ProfileRegistry.GetBOSSAProfile(string.Empty);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// "bossa.AttentionConeAngle" -> "bossa", "attentionconeangle" (lower case)
+	//------------------------------------------------------------------------------------------------
+	protected bool SplitParameterKey(string key, out string group, out string parameter)
+	{
+		int dot = key.IndexOf(".");
+		if (dot <= 0 || dot >= key.Length() - 1)
+			return false;
+
+		group = key.Substring(0, dot);
+		parameter = key.Substring(dot + 1, key.Length() - dot - 1);
+		group.ToLower();
+		parameter.ToLower();
+		return true;
+	}
+}
+#endif
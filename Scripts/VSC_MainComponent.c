@@ -17,8 +17,10 @@ class VSC_MainComponent : ScriptedGameComponent
 	{
 		super.OnPostInit(owner);
 		
+#ifndef VSC_NO_LOGGING
 		Print("[VSC] Virtual Sound Compressor initialized", LogLevel.NORMAL);
 		Print("[VSC] Note: Attach VSC_HeadgearManagerComponent to enable automatic headgear detection", LogLevel.NORMAL);
+#endif
 	}
 	
 	//------------------------------------------------------------------------------------------------
@@ -26,6 +28,8 @@ class VSC_MainComponent : ScriptedGameComponent
 	{
 		super.OnDelete(owner);
 		
+#ifndef VSC_NO_LOGGING
 		Print("[VSC] Virtual Sound Compressor cleanup", LogLevel.NORMAL);
+#endif
 	}
 }
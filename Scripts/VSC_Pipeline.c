@@ -0,0 +1,310 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Pipeline
+// Protection and BOSSA stages plus the hearing output, ticked as one unit. Used by the local
+// controller, trace replays and the test suite, so all of them exercise the same code.
+// An optional audio output follows the compressor gain on the client's actual mix.
+// The pipeline samples its input's time once per entry point into a clock all stages read.
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+class VSC_Pipeline
+{
+	private VSC_InputProvider m_Input;
+	private ref VSC_Clock m_Clock = new VSC_Clock();
+	private ref VSC_ProtectionProcessor m_Protection;
+	private ref VSC_BOSSAProcessor m_BOSSA;
+	private ref VSC_HearingOutput m_Output; // Null while detached
+	private ref VSC_AudioOutput m_Audio; // Optional, follows m_Output's attach state
+	private VSC_ProtectionProfile m_ProtectionProfile;
+	private VSC_BOSSAProfile m_BOSSAProfile;
+	private bool m_bIsActive = false;
+
+	//------------------------------------------------------------------------------------------------
+	// Either profile may be null to leave that stage out
+	//------------------------------------------------------------------------------------------------
+	void VSC_Pipeline(VSC_InputProvider input, VSC_ProtectionProfile protectionProfile, VSC_BOSSAProfile bossaProfile, VSC_HearingOutput output)
+	{
+		m_Input = input;
+		m_ProtectionProfile = protectionProfile;
+		m_BOSSAProfile = bossaProfile;
+
+		if (protectionProfile)
+			m_Protection = new VSC_ProtectionProcessor(input, m_Clock, protectionProfile);
+
+		if (bossaProfile)
+			m_BOSSA = new VSC_BOSSAProcessor(input, m_Clock, bossaProfile);
+
+		m_Output = output;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void SetStageStats(VSC_StageStats stats)
+	{
+		if (m_Protection)
+			m_Protection.SetStageStats(stats);
+
+		if (m_BOSSA)
+			m_BOSSA.SetStageStats(stats);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Adaptive-learning state carried across activations (set before Activate)
+	//------------------------------------------------------------------------------------------------
+	void SetLearnedState(VSC_LearnedState state)
+	{
+		if (m_BOSSA)
+			m_BOSSA.SetLearnedState(state);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Audio output for the compressor gain (set before Activate)
+	//------------------------------------------------------------------------------------------------
+	void SetAudioOutput(VSC_AudioOutput audio)
+	{
+		m_Audio = audio;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Activate(float originalAuditoryRange)
+	{
+		m_Clock.Reset();
+		m_Clock.Sample(m_Input.GetTime());
+		m_Output.Begin(originalAuditoryRange);
+
+		if (m_Audio)
+			m_Audio.Begin();
+
+		if (m_Protection)
+			m_Protection.Activate();
+
+		if (m_BOSSA)
+			m_BOSSA.Activate(originalAuditoryRange);
+
+		m_bIsActive = true;
+		ApplyOutput();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Stop all stages and restore the original hearing range
+	//------------------------------------------------------------------------------------------------
+	void Deactivate()
+	{
+		if (!m_bIsActive)
+			return;
+
+		if (m_Protection)
+			m_Protection.Deactivate();
+
+		if (m_BOSSA)
+			m_BOSSA.Deactivate();
+
+		if (m_Output)
+			m_Output.Restore();
+
+		if (m_Audio)
+			m_Audio.Restore();
+
+		m_bIsActive = false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Restore and release the output but keep all stage state (possession change, respawn)
+	//------------------------------------------------------------------------------------------------
+	void Detach()
+	{
+		if (!m_Output)
+			return;
+
+		if (m_bIsActive)
+			m_Output.Restore();
+
+		if (m_Audio)
+			m_Audio.Restore();
+
+		m_Output = null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Continue on a new output (new character) with the state built up so far
+	//------------------------------------------------------------------------------------------------
+	void Attach(VSC_HearingOutput output, float originalAuditoryRange)
+	{
+		Detach();
+
+		m_Output = output;
+		m_Output.Begin(originalAuditoryRange);
+
+		if (m_Audio)
+			m_Audio.Begin();
+
+		// The listener moved - re-validate sources at once instead of waiting for their schedule
+		m_Clock.Sample(m_Input.GetTime());
+		if (m_BOSSA)
+			m_BOSSA.Retarget(originalAuditoryRange);
+
+		ApplyOutput();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool IsAttached()
+	{
+		return m_Output != null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Whether this pipeline was built for the given profiles (and can be reused for them)
+	//------------------------------------------------------------------------------------------------
+	bool UsesProfiles(VSC_ProtectionProfile protectionProfile, VSC_BOSSAProfile bossaProfile)
+	{
+		return m_ProtectionProfile == protectionProfile && m_BOSSAProfile == bossaProfile;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Retune the existing stages in place (runtime tuning). A stage the pipeline was built without
+	// stays off - a null profile here keeps the current one.
+	//------------------------------------------------------------------------------------------------
+	void SetProfiles(VSC_ProtectionProfile protectionProfile, VSC_BOSSAProfile bossaProfile)
+	{
+		if (m_Protection && protectionProfile)
+		{
+			m_Protection.SetProfile(protectionProfile);
+			m_ProtectionProfile = protectionProfile;
+		}
+
+		if (m_BOSSA && bossaProfile)
+		{
+			m_Clock.Sample(m_Input.GetTime());
+			m_BOSSA.SetProfile(bossaProfile);
+			m_BOSSAProfile = bossaProfile;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	VSC_ProtectionProfile GetProtectionProfile()
+	{
+		return m_ProtectionProfile;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	VSC_BOSSAProfile GetBOSSAProfile()
+	{
+		return m_BOSSAProfile;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// One processing tick for all stages
+	//------------------------------------------------------------------------------------------------
+	void Update()
+	{
+		if (!m_bIsActive || !m_Output)
+			return;
+
+		m_Clock.Sample(m_Input.GetTime());
+		if (m_Protection)
+			m_Protection.Update();
+
+		if (m_BOSSA)
+			m_BOSSA.Update();
+
+		ApplyOutput();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// An explosion went off at the given world time (ms) - live, and again at the same time in replays
+	//------------------------------------------------------------------------------------------------
+	void HandleExplosion(vector position, float time)
+	{
+		if (!m_bIsActive || !m_Output || !m_Protection)
+			return;
+
+		m_Clock.Sample(time);
+		m_Protection.HandleExplosion(position);
+		ApplyOutput();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// A tracked entity was deleted (see VSC_EntityEvents)
+	//------------------------------------------------------------------------------------------------
+	void OnSourceDeleted(string id)
+	{
+		if (m_BOSSA)
+			m_BOSSA.OnSourceDeleted(id);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Once per rendered frame: smooth the audio output towards the compressor gain. The caller passes
+	// the world time, as a recorded input only moves on once per tick.
+	//------------------------------------------------------------------------------------------------
+	void UpdateAudio(float time)
+	{
+		if (!m_Audio || !m_Output)
+			return;
+
+		m_Clock.Sample(time);
+		m_Audio.Update(m_Clock.GetMs());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Combine stage gains and hand them to the outputs (which skip unchanged values)
+	//------------------------------------------------------------------------------------------------
+	void ApplyOutput()
+	{
+		if (!m_Output)
+			return;
+
+		m_Output.Apply(GetGain());
+
+		// The mix follows the compressor only - BOSSA shapes the auditory range
+		if (m_Audio && m_Protection)
+			m_Audio.SetTarget(m_Protection.GetGain());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	float GetGain()
+	{
+		float gain = 1.0;
+		if (m_Protection)
+			gain *= m_Protection.GetGain();
+
+		if (m_BOSSA)
+			gain *= m_BOSSA.GetGain();
+
+		return gain;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool IsActive()
+	{
+		return m_bIsActive;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	VSC_Clock GetClock()
+	{
+		return m_Clock;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	VSC_ProtectionProcessor GetProtection()
+	{
+		return m_Protection;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	VSC_BOSSAProcessor GetBOSSA()
+	{
+		return m_BOSSA;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	VSC_HearingOutput GetOutput()
+	{
+		return m_Output;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	VSC_AudioOutput GetAudioOutput()
+	{
+		return m_Audio;
+	}
+}
@@ -0,0 +1,25 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Player Controller Hook
+// Forwards possession changes of the local player to VSC_LocalController, so hearing is bound
+// on the first frame a character is controlled (spawn, respawn, join in progress).
+// Not compiled with VSC_SERVER_LITE.
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+#ifndef VSC_SERVER_LITE
+modded class SCR_PlayerController
+{
+	//------------------------------------------------------------------------------------------------
+	override void OnControlledEntityChanged(IEntity from, IEntity to)
+	{
+		super.OnControlledEntityChanged(from, to);
+
+		if (this != GetGame().GetPlayerController())
+			return;
+
+		VSC_LocalController controller = VSC_LocalController.GetInstance();
+		if (controller)
+			controller.OnControlledEntityChanged(to);
+	}
+}
+#endif
@@ -0,0 +1,210 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Tuning Profiles
+// Shared tuning data read by the processors. Profiles are config resources (.conf) created in
+// the Workbench and referenced by headgear components or a server preset. Each resource is
+// loaded once by VSC_ProfileRegistry and the same instance is handed to every user - treat
+// profiles as immutable after loading.
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------------------------
+// Active hearing protection tuning (field defaults match the attribute defaults)
+//------------------------------------------------------------------------------------------------
+[BaseContainerProps(configRoot: true)]
+class VSC_ProtectionProfile
+{
+	[Attribute(defvalue: "1.75", uiwidget: UIWidgets.Slider, desc: "Auditory range multiplier for quiet sounds.", params: "1.0 5.0 0.1")]
+	float m_fBoostMultiplier = 1.75;
+
+	[Attribute(defvalue: "0.25", uiwidget: UIWidgets.Slider, desc: "Auditory range multiplier when dampening loud sounds.", params: "0.1 1.0 0.05")]
+	float m_fDampenMultiplier = 0.25;
+
+	[Attribute(defvalue: "25", uiwidget: UIWidgets.EditBox, desc: "The maximum distance (meters) from an explosion to trigger the dampening effect.")]
+	float m_fDampenTriggerRange = 25.0;
+
+	[Attribute(defvalue: "400", uiwidget: UIWidgets.EditBox, desc: "How long the dampening effect lasts in milliseconds (ms).")]
+	int m_iDampenDurationMs = 400;
+
+	[Attribute(defvalue: "true", uiwidget: UIWidgets.CheckBox, desc: "Enable dampening for weapon sounds (gunshots).")]
+	bool m_bDetectWeaponSounds = true;
+
+	[Attribute(defvalue: "15", uiwidget: UIWidgets.EditBox, desc: "The maximum distance (meters) from weapon fire to trigger dampening.")]
+	float m_fWeaponSoundTriggerRange = 15.0;
+
+	[Attribute(defvalue: "200", uiwidget: UIWidgets.EditBox, desc: "How long weapon sound dampening lasts in milliseconds (ms).")]
+	int m_iWeaponSoundDurationMs = 200;
+
+	[Attribute(defvalue: "0.5", uiwidget: UIWidgets.Slider, desc: "Minimum time a dampening is held (seconds) to prevent rapid toggling. Loud events within it extend the dampening.", params: "0.1 2.0 0.1")]
+	float m_fDampeningCooldown = 0.5;
+}
+
+//------------------------------------------------------------------------------------------------
+// BOSSA tuning (field defaults match the attribute defaults)
+//------------------------------------------------------------------------------------------------
+[BaseContainerProps(configRoot: true)]
+class VSC_BOSSAProfile
+{
+	// --- Spatial Filtering Parameters ---
+	[Attribute(defvalue: "45", uiwidget: UIWidgets.EditBox, desc: "Field of attention cone angle in degrees. Sounds within this cone are enhanced.")]
+	float m_fAttentionConeAngle = 45.0;
+
+	[Attribute(defvalue: "2.0", uiwidget: UIWidgets.Slider, desc: "Enhancement multiplier for sounds in the attention cone (front direction).", params: "1.0 5.0 0.1")]
+	float m_fFrontEnhancementMultiplier = 2.0;
+
+	[Attribute(defvalue: "0.5", uiwidget: UIWidgets.Slider, desc: "Suppression multiplier for sounds outside the attention cone (background noise).", params: "0.1 1.0 0.05")]
+	float m_fBackgroundSuppressionMultiplier = 0.5;
+
+	// --- Selective Attention Parameters ---
+	[Attribute(defvalue: "true", uiwidget: UIWidgets.CheckBox, desc: "Enable enhanced detection of voice/communication sounds.")]
+	bool m_bEnhanceVoices = true;
+
+	[Attribute(defvalue: "true", uiwidget: UIWidgets.CheckBox, desc: "Enable enhanced detection of footsteps and movement sounds.")]
+	bool m_bEnhanceMovement = true;
+
+	[Attribute(defvalue: "true", uiwidget: UIWidgets.CheckBox, desc: "Enable enhanced detection of enemy combat sounds.")]
+	bool m_bEnhanceCombat = true;
+
+	[Attribute(defvalue: "1.5", uiwidget: UIWidgets.Slider, desc: "Multiplier for important sound categories (voices, movement, combat).", params: "1.0 3.0 0.1")]
+	float m_fImportantSoundMultiplier = 1.5;
+
+	// --- Inhibitory Filtering Parameters (Brain-Inspired Noise Cancellation) ---
+	[Attribute(defvalue: "0.7", uiwidget: UIWidgets.Slider, desc: "Inhibitory strength for competing sounds (0.0 = no inhibition, 1.0 = maximum).", params: "0.0 1.0 0.05")]
+	float m_fInhibitoryStrength = 0.7;
+
+	[Attribute(defvalue: "10", uiwidget: UIWidgets.EditBox, desc: "Maximum number of concurrent sound sources to process for spatial filtering.")]
+	int m_iMaxTrackedSources = 10;
+
+	// --- Temporal Processing (Brain's timing-based filtering) ---
+	[Attribute(defvalue: "0.1", uiwidget: UIWidgets.Slider, desc: "Smoothing time constant in seconds for per-source intensity and angle (brain's temporal processing window). Persistence builds over 10 windows.", params: "0.05 0.5 0.01")]
+	float m_fTemporalWindow = 0.1;
+
+	[Attribute(defvalue: "true", uiwidget: UIWidgets.CheckBox, desc: "Use temporal coherence to enhance sounds that persist over time (like voices).")]
+	bool m_bUseTemporalCoherence = true;
+
+	// --- Advanced Features ---
+	[Attribute(defvalue: "false", uiwidget: UIWidgets.CheckBox, desc: "Enable adaptive learning - adjusts filtering based on player behavior.")]
+	bool m_bAdaptiveLearning = false;
+
+	[Attribute(defvalue: "0.3", uiwidget: UIWidgets.Slider, desc: "Adaptation rate for learning player preferences (0.0 = no adaptation, 1.0 = instant).", params: "0.0 1.0 0.05")]
+	float m_fAdaptationRate = 0.3;
+}
+
+//------------------------------------------------------------------------------------------------
+// Server-wide tuning: when set, replaces every headgear profile and the defaults
+//------------------------------------------------------------------------------------------------
+[BaseContainerProps(configRoot: true)]
+class VSC_TuningPreset
+{
+	[Attribute(desc: "Hearing protection tuning for all headgear (empty = keep per-headgear profiles)")]
+	ref VSC_ProtectionProfile m_Protection;
+
+	[Attribute(desc: "BOSSA tuning for all headgear (empty = keep per-headgear profiles)")]
+	ref VSC_BOSSAProfile m_BOSSA;
+}
+
+//------------------------------------------------------------------------------------------------
+// Loads each profile resource once and hands out the shared instance
+//------------------------------------------------------------------------------------------------
+class VSC_ProfileRegistry
+{
+	private static ref map<ResourceName, ref VSC_ProtectionProfile> s_mProtectionProfiles = new map<ResourceName, ref VSC_ProtectionProfile>();
+	private static ref map<ResourceName, ref VSC_BOSSAProfile> s_mBOSSAProfiles = new map<ResourceName, ref VSC_BOSSAProfile>();
+	private static ref VSC_ProtectionProfile s_DefaultProtectionProfile = new VSC_ProtectionProfile();
+	private static ref VSC_BOSSAProfile s_DefaultBOSSAProfile = new VSC_BOSSAProfile();
+	private static ref VSC_TuningPreset s_Preset;
+
+	//------------------------------------------------------------------------------------------------
+	// Protection profile for a resource (empty = defaults), the server preset takes precedence
+	//------------------------------------------------------------------------------------------------
+	static VSC_ProtectionProfile GetProtectionProfile(ResourceName resource)
+	{
+		if (s_Preset && s_Preset.m_Protection)
+			return s_Preset.m_Protection;
+
+		if (resource.IsEmpty())
+			return s_DefaultProtectionProfile;
+
+		VSC_ProtectionProfile profile;
+		if (s_mProtectionProfiles.Find(resource, profile))
+			return profile;
+
+		profile = VSC_ProtectionProfile.Cast(Load(resource));
+		if (!profile)
+			profile = s_DefaultProtectionProfile;
+
+		s_mProtectionProfiles.Insert(resource, profile);
+		return profile;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// BOSSA profile for a resource (empty = defaults), the server preset takes precedence
+	//------------------------------------------------------------------------------------------------
+	static VSC_BOSSAProfile GetBOSSAProfile(ResourceName resource)
+	{
+		if (s_Preset && s_Preset.m_BOSSA)
+			return s_Preset.m_BOSSA;
+
+		if (resource.IsEmpty())
+			return s_DefaultBOSSAProfile;
+
+		VSC_BOSSAProfile profile;
+		if (s_mBOSSAProfiles.Find(resource, profile))
+			return profile;
+
+		profile = VSC_BOSSAProfile.Cast(Load(resource));
+		if (!profile)
+			profile = s_DefaultBOSSAProfile;
+
+		s_mBOSSAProfiles.Insert(resource, profile);
+		return profile;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Apply a server preset (null = per-headgear profiles again)
+	//------------------------------------------------------------------------------------------------
+	static void SetPreset(VSC_TuningPreset preset)
+	{
+		s_Preset = preset;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Load and apply a preset resource, false if it can't be loaded (empty clears the preset)
+	//------------------------------------------------------------------------------------------------
+	static bool LoadPreset(ResourceName resource)
+	{
+		if (resource.IsEmpty())
+		{
+			s_Preset = null;
+			return true;
+		}
+
+		VSC_TuningPreset preset = VSC_TuningPreset.Cast(Load(resource));
+		if (!preset)
+			return false;
+
+		s_Preset = preset;
+#ifndef VSC_NO_LOGGING
+		Print("[VSC] Tuning preset applied: " + resource, LogLevel.NORMAL);
+#endif
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static VSC_TuningPreset GetPreset()
+	{
+		return s_Preset;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static Managed Load(ResourceName resource)
+	{
+		Resource container = BaseContainerTools.LoadContainer(resource);
+		if (!container || !container.IsValid())
+		{
+			Print("[VSC] Cannot load tuning config: " + resource, LogLevel.WARNING);
+			return null;
+		}
+
+		return BaseContainerTools.CreateInstanceFromContainer(container.GetResource().ToBaseContainer());
+	}
+}
@@ -0,0 +1,241 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Active Hearing Protection Processor
+// Boosts quiet sounds and dampens loud ones for the listener of its input provider.
+// Owned and ticked by VSC_LocalController (or a replay), tuned by a VSC_ProtectionProfile.
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+class VSC_ProtectionProcessor
+{
+	private VSC_InputProvider m_Input;
+	private VSC_Clock m_Clock;
+	private ref VSC_ProtectionProfile m_Profile;
+	private VSC_StageStats m_Stats;
+	private bool m_bIsActive = false;
+	private bool m_bIsDampened = false;
+	private float m_fLastDampeningTime = 0.0;
+	private float m_fDampenEndTime = 0.0;
+	private int m_iDampeningCount = 0; // Dampenings started (extensions not counted), for telemetry
+#ifndef VSC_NO_WEAPON_MONITOR
+	private ref array<ref VSC_WeaponFire> m_aWeaponFire = {};
+	private const float MAX_WEAPON_SEVERITY = 2.0; // Close, loud reports dampen up to this many times the profile duration
+#endif
+
+	// Acoustic environment (open terrain leaves the profile values unchanged)
+	private const float ENCLOSED_BOOST_REDUCTION = 0.5; // Rooms and cabins carry quiet sounds already - up to half the boost
+	private const float REFLECTION_DAMPEN_STRENGTH = 0.5; // Close hard surfaces make blasts louder - up to twice the attenuation
+	private float m_fBoostMultiplier;
+	private float m_fDampenMultiplier;
+
+	//------------------------------------------------------------------------------------------------
+	void VSC_ProtectionProcessor(VSC_InputProvider input, VSC_Clock clock, VSC_ProtectionProfile profile)
+	{
+		m_Input = input;
+		m_Clock = clock;
+		m_Profile = profile;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Optional stage timing (benchmarks and replays)
+	//------------------------------------------------------------------------------------------------
+	void SetStageStats(VSC_StageStats stats)
+	{
+		m_Stats = stats;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Swap the tuning in place (runtime tuning), a running dampening keeps its end time
+	//------------------------------------------------------------------------------------------------
+	void SetProfile(VSC_ProtectionProfile profile)
+	{
+		m_Profile = profile;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Activate()
+	{
+		m_bIsDampened = false;
+		m_fLastDampeningTime = -float.MAX; // No cooldown before the first trigger
+		UpdateEnvironment();
+		m_bIsActive = true;
+
+#ifndef VSC_NO_LOGGING
+		Print("[VSC] Active Hearing Protection Activated. Boost Applied.", LogLevel.NORMAL);
+#endif
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Deactivate()
+	{
+		if (!m_bIsActive)
+			return;
+
+		m_bIsActive = false;
+		m_bIsDampened = false;
+#ifndef VSC_NO_LOGGING
+		Print("[VSC] Active Hearing Protection Deactivated. Hearing restored to normal.", LogLevel.NORMAL);
+#endif
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Called on every processing tick
+	//------------------------------------------------------------------------------------------------
+	void Update()
+	{
+		if (!m_bIsActive)
+			return;
+
+		int startTick;
+		if (m_Stats)
+			startTick = System.GetTickCount();
+
+		float currentTime = m_Clock.GetMs();
+		UpdateEnvironment();
+
+		// Restore the boost after dampening period, never sooner than the cooldown after it started
+		if (m_bIsDampened && currentTime >= m_fDampenEndTime && !IsCoolingDown())
+			RestoreBoost();
+
+#ifndef VSC_NO_WEAPON_MONITOR
+		if (m_Profile.m_bDetectWeaponSounds)
+			MonitorWeaponSounds(currentTime);
+#endif
+
+		if (m_Stats)
+			m_Stats.Add(EVSC_Stage.PROTECTION, startTick);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Auditory range multiplier contributed by the protection stage
+	//------------------------------------------------------------------------------------------------
+	float GetGain()
+	{
+		if (!m_bIsActive)
+			return 1.0;
+
+		if (m_bIsDampened)
+			return m_fDampenMultiplier;
+
+		return m_fBoostMultiplier;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Adapt boost and dampening to the listener's surroundings
+	//------------------------------------------------------------------------------------------------
+	protected void UpdateEnvironment()
+	{
+		VSC_Acoustics acoustics = m_Input.GetListenerAcoustics();
+		m_fBoostMultiplier = 1.0 + (m_Profile.m_fBoostMultiplier - 1.0) * (1.0 - ENCLOSED_BOOST_REDUCTION * acoustics.m_fEnclosure);
+		m_fDampenMultiplier = m_Profile.m_fDampenMultiplier * (1.0 - REFLECTION_DAMPEN_STRENGTH * acoustics.m_fHardSurfaces);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool IsDampened()
+	{
+		return m_bIsDampened;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Dampenings started since this processor was created
+	//------------------------------------------------------------------------------------------------
+	int GetDampeningCount()
+	{
+		return m_iDampeningCount;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Called for ANY explosion that happens in the world
+	//------------------------------------------------------------------------------------------------
+	void HandleExplosion(vector position)
+	{
+		if (!m_bIsActive)
+			return;
+
+		float currentTime = m_Clock.GetMs();
+
+		// Calculate distance from the explosion to the player
+		float distance = vector.Distance(m_Input.GetListenerOrigin(), position);
+
+		// If the explosion is within our trigger range, apply the dampening effect
+		if (distance <= m_Profile.m_fDampenTriggerRange)
+		{
+			ApplyDampening(currentTime, m_Profile.m_iDampenDurationMs);
+		}
+	}
+
+#ifndef VSC_NO_WEAPON_MONITOR
+	//------------------------------------------------------------------------------------------------
+	// Monitor for weapon sounds (gunshots) in the vicinity
+	//------------------------------------------------------------------------------------------------
+	protected void MonitorWeaponSounds(float currentTime)
+	{
+		// The trigger range is set for the reference report - search as far as the loudest one carries
+		float triggerRange = m_Profile.m_fWeaponSoundTriggerRange;
+		m_aWeaponFire.Clear();
+		m_Input.CollectWeaponFire(triggerRange * VSC_WeaponSignatures.MAX_RANGE_SCALE, m_aWeaponFire);
+
+		// Severity of the loudest shot: its own trigger range (calibre, suppressor, muzzle direction)
+		// over its distance, 1 at the edge of that range
+		vector listener = m_Input.GetListenerOrigin();
+		float severity = 0.0;
+		foreach (VSC_WeaponFire fire : m_aWeaponFire)
+		{
+			float distance = Math.Max(vector.Distance(listener, fire.m_vPosition), 1.0);
+			severity = Math.Max(severity, triggerRange * fire.GetRangeScale(listener) / distance);
+		}
+		m_aWeaponFire.Clear();
+
+		// Weapon fired within its range, apply dampening immediately - longer for closer, louder shots
+		if (severity > 1.0)
+		{
+			int durationMs = m_Profile.m_iWeaponSoundDurationMs * Math.Min(severity, MAX_WEAPON_SEVERITY);
+			ApplyDampening(currentTime, durationMs);
+		}
+	}
+#endif
+
+	//------------------------------------------------------------------------------------------------
+	// Within the profile's cooldown (seconds) since the current dampening started
+	//------------------------------------------------------------------------------------------------
+	protected bool IsCoolingDown()
+	{
+		return !m_Clock.HasElapsed(m_fLastDampeningTime, VSC_Clock.SecondsToMs(m_Profile.m_fDampeningCooldown));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Apply audio dampening effect - a loud event always starts or extends one, the cooldown only
+	// holds back the release so the boost cannot toggle rapidly
+	//------------------------------------------------------------------------------------------------
+	protected void ApplyDampening(float currentTime, int durationMs = -1)
+	{
+		// Use provided duration or default
+		if (durationMs < 0)
+			durationMs = m_Profile.m_iDampenDurationMs;
+
+		// Overlapping loud events extend an active dampening, never shorten it
+		if (m_bIsDampened)
+		{
+			m_fDampenEndTime = Math.Max(m_fDampenEndTime, currentTime + durationMs);
+			return;
+		}
+
+		m_bIsDampened = true;
+		m_iDampeningCount++;
+		m_fLastDampeningTime = currentTime;
+		m_fDampenEndTime = currentTime + durationMs;
+#ifndef VSC_NO_LOGGING
+		Print("[VSC] LOUD NOISE DETECTED! Dampening audio.", LogLevel.WARNING);
+#endif
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Restore the boost after dampening period
+	//------------------------------------------------------------------------------------------------
+	protected void RestoreBoost()
+	{
+		m_bIsDampened = false;
+#ifndef VSC_NO_LOGGING
+		Print("[VSC] Dampening finished. Boost restored.", LogLevel.NORMAL);
+#endif
+	}
+}
@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Replay Runner
+// Feeds a recorded input trace through the protection and BOSSA processors as fast as possible
+// and writes the resulting gain timeline and per-stage timings. Runs headless, e.g.
+//   ArmaReforgerServer ... -vscReplay $profile:VSC/session.vsctrace -vscReplayQuit
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+class VSC_ReplayRunner
+{
+	static const string CLI_REPLAY = "vscReplay";
+	static const string CLI_REPLAY_QUIT = "vscReplayQuit";
+
+	private ref VSC_StageStats m_Stats = new VSC_StageStats();
+	private int m_iFrameCount;
+	private int m_iDampenedFrames;
+
+	//------------------------------------------------------------------------------------------------
+	// Run the trace passed with -vscReplay (if any)
+	//------------------------------------------------------------------------------------------------
+	static void RunFromCommandLine()
+	{
+		string tracePath;
+		if (!System.GetCLIParam(CLI_REPLAY, tracePath) || tracePath.IsEmpty())
+			return;
+
+		VSC_ReplayRunner runner = new VSC_ReplayRunner();
+		runner.Run(tracePath, new VSC_ProtectionProfile(), new VSC_BOSSAProfile());
+
+		if (System.IsCLIParam(CLI_REPLAY_QUIT))
+			GetGame().RequestClose();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Replay a trace and write <trace>_gain.csv and <trace>_timings.txt next to it
+	//------------------------------------------------------------------------------------------------
+	bool Run(string tracePath, VSC_ProtectionProfile protectionProfile, VSC_BOSSAProfile bossaProfile)
+	{
+		VSC_TraceReader reader = new VSC_TraceReader();
+		if (!reader.Open(tracePath))
+		{
+			Print("[VSC Replay] Cannot open trace: " + tracePath, LogLevel.ERROR);
+			return false;
+		}
+
+		string outputPrefix = tracePath;
+		outputPrefix.Replace(VSC_Trace.EXTENSION, string.Empty);
+
+		FileHandle gainFile = FileIO.OpenFile(outputPrefix + "_gain.csv", FileMode.WRITE);
+		if (!gainFile)
+		{
+			Print("[VSC Replay] Cannot write output: " + outputPrefix + "_gain.csv", LogLevel.ERROR);
+			reader.Close();
+			return false;
+		}
+
+		gainFile.WriteLine("time,protection_gain,bossa_gain,total_gain,dampened,tracked_sources");
+
+		VSC_FrameInput input = new VSC_FrameInput();
+		VSC_InputFrame frame = new VSC_InputFrame();
+
+		VSC_Pipeline pipeline = new VSC_Pipeline(input, protectionProfile, bossaProfile, new VSC_HearingOutput());
+		pipeline.SetStageStats(m_Stats);
+		VSC_ProtectionProcessor protection = pipeline.GetProtection();
+		VSC_BOSSAProcessor bossa = pipeline.GetBOSSA();
+
+		m_Stats.Reset();
+		m_iFrameCount = 0;
+		m_iDampenedFrames = 0;
+		int startTick = System.GetTickCount();
+
+		while (reader.ReadFrame(frame))
+		{
+			input.SetFrame(frame);
+
+			if (m_iFrameCount == 0)
+				pipeline.Activate(reader.GetOriginalAuditoryRange());
+
+			// At the time they went off while recording, before this frame's tick
+			foreach (int i, vector explosionPos : frame.m_aExplosions)
+			{
+				pipeline.HandleExplosion(explosionPos, frame.m_aExplosionTimes[i]);
+			}
+
+			pipeline.Update();
+
+			float protectionGain = protection.GetGain();
+			float bossaGain = bossa.GetGain();
+			bool dampened = protection.IsDampened();
+			if (dampened)
+				m_iDampenedFrames++;
+
+			gainFile.WriteLine(string.Format("%1,%2,%3,%4,%5,%6", frame.m_fTime, protectionGain, bossaGain, protectionGain * bossaGain, dampened, bossa.GetTrackedSourceCount()));
+			m_iFrameCount++;
+		}
+
+		int totalMs = System.GetTickCount() - startTick;
+		pipeline.Deactivate();
+		reader.Close();
+		gainFile.Close();
+
+		WriteTimings(outputPrefix + "_timings.txt", tracePath, totalMs);
+
+		Print(string.Format("[VSC Replay] %1: %2 frames in %3 ms", tracePath, m_iFrameCount, totalMs), LogLevel.NORMAL);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	VSC_StageStats GetStageStats()
+	{
+		return m_Stats;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void WriteTimings(string path, string tracePath, int totalMs)
+	{
+		FileHandle file = FileIO.OpenFile(path, FileMode.WRITE);
+		if (!file)
+			return;
+
+		file.WriteLine("trace: " + tracePath);
+		file.WriteLine("frames: " + m_iFrameCount);
+		file.WriteLine("dampened_frames: " + m_iDampenedFrames);
+		file.WriteLine("total_ms: " + totalMs);
+
+		for (int stage = 0; stage < EVSC_Stage.COUNT; stage++)
+		{
+			file.WriteLine(string.Format("%1: calls=%2 total_ms=%3 avg_us=%4", VSC_StageStats.GetStageName(stage), m_Stats.GetCalls(stage), m_Stats.GetTotalMs(stage), m_Stats.GetAverageMicroseconds(stage)));
+		}
+
+		file.Close();
+	}
+}
@@ -0,0 +1,267 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Sector Histogram
+// Tracked sources and distant source clusters binned by listener-relative azimuth and distance
+// band. Every source keeps the bin and the values it contributed, so adding, refreshing and
+// evicting it are O(1) and the filter kernels read per-sector sums in O(sectors) however many
+// sources are tracked. Background is kept per band and weighted by distance when read: a
+// competing source close by masks more than battle noise far off.
+// Azimuth is signed, 0 = ahead, positive = right, +-180 = behind.
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+class VSC_SectorHistogram
+{
+	static const int SECTOR_COUNT = 16;
+	static const float SECTOR_WIDTH = 22.5; // 360 / SECTOR_COUNT
+	static const int BAND_COUNT = 3;
+	static const float NEAR_BAND_DISTANCE = 15.0; // Band 0 below, band 1 up to MID_BAND_DISTANCE, band 2 beyond
+	static const float MID_BAND_DISTANCE = 50.0;
+	static const float MID_BAND_BACKGROUND_WEIGHT = 0.7; // Background weight relative to the near band
+	static const float FAR_BAND_BACKGROUND_WEIGHT = 0.4;
+
+	// Per sector, read by the filter kernels
+	protected ref array<int> m_aCount = {};
+	protected ref array<float> m_aPresence = {}; // Sum of persistence
+	protected ref array<float> m_aFootstepPresence = {};
+	protected ref array<float> m_aImportantPresence = {}; // Important sources other than footsteps
+	protected ref array<int> m_aImportantCount = {};
+	protected ref array<float> m_aImportantAngle = {}; // Sum of smoothed angles of important sources
+
+	// Per sector x band bin
+	protected ref array<int> m_aBinCount = {};
+	protected ref array<float> m_aBinBackground = {}; // Sum of smoothed intensity x persistence
+
+	protected int m_iTotalCount;
+
+	//------------------------------------------------------------------------------------------------
+	void VSC_SectorHistogram()
+	{
+		m_aCount.Resize(SECTOR_COUNT);
+		m_aPresence.Resize(SECTOR_COUNT);
+		m_aFootstepPresence.Resize(SECTOR_COUNT);
+		m_aImportantPresence.Resize(SECTOR_COUNT);
+		m_aImportantCount.Resize(SECTOR_COUNT);
+		m_aImportantAngle.Resize(SECTOR_COUNT);
+		m_aBinCount.Resize(SECTOR_COUNT * BAND_COUNT);
+		m_aBinBackground.Resize(SECTOR_COUNT * BAND_COUNT);
+		Clear();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Sector of a signed azimuth in degrees
+	//------------------------------------------------------------------------------------------------
+	static int GetSector(float azimuth)
+	{
+		int sector = Math.Floor((azimuth + 180.0) / SECTOR_WIDTH);
+		return Math.ClampInt(sector, 0, SECTOR_COUNT - 1);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Signed azimuth of a sector's centre in degrees
+	//------------------------------------------------------------------------------------------------
+	static float GetSectorAzimuth(int sector)
+	{
+		return -180.0 + (sector + 0.5) * SECTOR_WIDTH;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Whether a sector belongs to a cone of the given half angle (resolution is one sector)
+	//------------------------------------------------------------------------------------------------
+	static bool IsInCone(int sector, float halfAngle)
+	{
+		return Math.AbsFloat(GetSectorAzimuth(sector)) <= halfAngle;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static int GetBand(float distance)
+	{
+		if (distance < NEAR_BAND_DISTANCE)
+			return 0;
+
+		if (distance < MID_BAND_DISTANCE)
+			return 1;
+
+		return 2;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// How much a band's background counts towards its sector's
+	//------------------------------------------------------------------------------------------------
+	static float GetBandBackgroundWeight(int band)
+	{
+		if (band == 0)
+			return 1.0;
+
+		if (band == 1)
+			return MID_BAND_BACKGROUND_WEIGHT;
+
+		return FAR_BAND_BACKGROUND_WEIGHT;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Clear()
+	{
+		for (int i = 0; i < SECTOR_COUNT; i++)
+		{
+			ClearSector(i);
+		}
+
+		m_iTotalCount = 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Insert a source or replace its previous contribution with its current smoothed state
+	//------------------------------------------------------------------------------------------------
+	void Update(VSC_TrackedSoundSource source)
+	{
+		Remove(source);
+
+		float azimuth = source.m_fSmoothedAngle;
+		if (source.m_bOnLeft)
+			azimuth = -azimuth;
+
+		int sector = GetSector(azimuth);
+		int bin = sector * BAND_COUNT + GetBand(source.m_fDistance);
+
+		source.m_iHistogramBin = bin;
+		source.m_fBinPresence = source.m_fPersistence;
+		source.m_fBinIntensity = source.m_fSmoothedIntensity;
+		source.m_fBinAngle = source.m_fSmoothedAngle;
+		source.m_bBinImportant = source.m_bIsImportant;
+		source.m_bBinFootstep = source.m_bIsFootstep;
+
+		Add(source, sector, bin, 1);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Remove(VSC_TrackedSoundSource source)
+	{
+		int bin = source.m_iHistogramBin;
+		if (bin < 0)
+			return;
+
+		int sector = bin / BAND_COUNT;
+		Add(source, sector, bin, -1);
+		source.m_iHistogramBin = -1;
+
+		// Empty sectors start from exact zeros again, no accumulated rounding drift
+		if (m_aCount[sector] == 0)
+			ClearSector(sector);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetTotalCount()
+	{
+		return m_iTotalCount;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetCount(int sector)
+	{
+		return m_aCount[sector];
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Presence of a sector: summed persistence, capped at one continuously present source
+	//------------------------------------------------------------------------------------------------
+	float GetPresence(int sector)
+	{
+		return Math.Min(m_aPresence[sector], 1.0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Background of a sector: smoothed intensity x persistence, weighted by distance band
+	//------------------------------------------------------------------------------------------------
+	float GetBackground(int sector)
+	{
+		float background = 0.0;
+		for (int band = 0; band < BAND_COUNT; band++)
+		{
+			background += m_aBinBackground[sector * BAND_COUNT + band] * GetBandBackgroundWeight(band);
+		}
+
+		return background;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	float GetFootstepPresence(int sector)
+	{
+		return Math.Min(m_aFootstepPresence[sector], 1.0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	float GetImportantPresence(int sector)
+	{
+		return Math.Min(m_aImportantPresence[sector], 1.0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetImportantCount(int sector)
+	{
+		return m_aImportantCount[sector];
+	}
+
+	//------------------------------------------------------------------------------------------------
+	float GetImportantAngle(int sector)
+	{
+		return m_aImportantAngle[sector];
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetBinCount(int sector, int band)
+	{
+		return m_aBinCount[sector * BAND_COUNT + band];
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Unweighted background of the sources in a sector and distance band
+	//------------------------------------------------------------------------------------------------
+	float GetBinBackground(int sector, int band)
+	{
+		return m_aBinBackground[sector * BAND_COUNT + band];
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Add (sign 1) or take back (sign -1) the contribution recorded on the source
+	//------------------------------------------------------------------------------------------------
+	protected void Add(VSC_TrackedSoundSource source, int sector, int bin, int sign)
+	{
+		m_iTotalCount += sign;
+		m_aCount[sector] = m_aCount[sector] + sign;
+		m_aPresence[sector] = m_aPresence[sector] + sign * source.m_fBinPresence;
+		m_aBinCount[bin] = m_aBinCount[bin] + sign;
+		m_aBinBackground[bin] = m_aBinBackground[bin] + sign * source.m_fBinIntensity * source.m_fBinPresence;
+
+		if (source.m_bBinFootstep)
+		{
+			m_aFootstepPresence[sector] = m_aFootstepPresence[sector] + sign * source.m_fBinPresence;
+		}
+		else if (source.m_bBinImportant)
+		{
+			m_aImportantPresence[sector] = m_aImportantPresence[sector] + sign * source.m_fBinPresence;
+		}
+
+		if (source.m_bBinImportant)
+		{
+			m_aImportantCount[sector] = m_aImportantCount[sector] + sign;
+			m_aImportantAngle[sector] = m_aImportantAngle[sector] + sign * source.m_fBinAngle;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void ClearSector(int sector)
+	{
+		m_aCount[sector] = 0;
+		m_aPresence[sector] = 0.0;
+		m_aFootstepPresence[sector] = 0.0;
+		m_aImportantPresence[sector] = 0.0;
+		m_aImportantCount[sector] = 0;
+		m_aImportantAngle[sector] = 0.0;
+
+		for (int band = 0; band < BAND_COUNT; band++)
+		{
+			m_aBinCount[sector * BAND_COUNT + band] = 0;
+			m_aBinBackground[sector * BAND_COUNT + band] = 0.0;
+		}
+	}
+}
@@ -0,0 +1,228 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Source Clusters
+// Distant sources that did not win one of the individually tracked slots, grouped by the world
+// grid cell they stand in. Each cluster keeps running sums of its members' positions and
+// intensities, so a member seen again, moving to another cell or expiring costs O(1), however
+// many hundreds of sources a battle brings. BOSSA feeds every cluster into the sector histogram
+// as one virtual source at its centroid, so the filters still hear a firefight beyond the top-K.
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------------------------
+// One grid cell of distant sources, binned and smoothed like a tracked source
+//------------------------------------------------------------------------------------------------
+class VSC_SourceCluster : VSC_TrackedSoundSource
+{
+	int m_iCell;
+	int m_iMemberCount;
+	int m_iImportantCount;
+	vector m_vPositionSum; // World positions of the members as last seen
+	float m_fIntensitySum; // Member intensities as last seen
+
+	//------------------------------------------------------------------------------------------------
+	vector GetCentroid()
+	{
+		if (m_iMemberCount == 0)
+			return vector.Zero;
+
+		return m_vPositionSum / m_iMemberCount;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+class VSC_ClusterMember
+{
+	string m_sId;
+	VSC_SourceCluster m_Cluster;
+	vector m_vPosition;
+	float m_fIntensity;
+	bool m_bImportant;
+	float m_fLastSeen;
+	int m_iIndex = -1; // Slot in the member list, for O(1) removal
+}
+
+//------------------------------------------------------------------------------------------------
+class VSC_SourceClusters
+{
+	static const float CELL_SIZE = 50.0; // Metres, about a squad in contact
+	static const int CELL_OFFSET = 2048; // Cell coordinates are shifted into 0..4095 (about 200 km)
+
+	private ref array<ref VSC_SourceCluster> m_aClusters = {};
+	private ref map<int, VSC_SourceCluster> m_mClustersByCell = new map<int, VSC_SourceCluster>();
+	private ref array<ref VSC_ClusterMember> m_aMembers = {};
+	private ref map<string, VSC_ClusterMember> m_mMembersById = new map<string, VSC_ClusterMember>();
+	private int m_iExpiryCursor = 0;
+
+	//------------------------------------------------------------------------------------------------
+	static int GetCell(vector position)
+	{
+		int x = Math.Floor(position[0] / CELL_SIZE) + CELL_OFFSET;
+		int z = Math.Floor(position[2] / CELL_SIZE) + CELL_OFFSET;
+		return Math.ClampInt(x, 0, CELL_OFFSET * 2 - 1) * CELL_OFFSET * 2 + Math.ClampInt(z, 0, CELL_OFFSET * 2 - 1);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Add a source or replace its previous contribution, moving it if it changed cells
+	//------------------------------------------------------------------------------------------------
+	void Update(string id, vector position, float intensity, bool important, float currentTime)
+	{
+		VSC_ClusterMember member = m_mMembersById.Get(id);
+		if (!member)
+		{
+			member = new VSC_ClusterMember();
+			member.m_sId = id;
+			member.m_iIndex = m_aMembers.Insert(member);
+			m_mMembersById.Insert(id, member);
+		}
+
+		int cell = GetCell(position);
+		if (member.m_Cluster && member.m_Cluster.m_iCell != cell)
+			Leave(member);
+
+		if (member.m_Cluster)
+		{
+			Contribute(member, -1);
+		}
+		else
+		{
+			member.m_Cluster = GetOrCreateCluster(cell);
+			member.m_Cluster.m_iMemberCount++;
+		}
+
+		member.m_vPosition = position;
+		member.m_fIntensity = intensity;
+		member.m_bImportant = important;
+		member.m_fLastSeen = currentTime;
+		Contribute(member, 1);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Drop a source (now tracked individually, deleted or gone silent), false if it was not clustered
+	//------------------------------------------------------------------------------------------------
+	bool Remove(string id)
+	{
+		VSC_ClusterMember member;
+		if (!m_mMembersById.Find(id, member))
+			return false;
+
+		Leave(member);
+		m_mMembersById.Remove(id);
+
+		// Unordered removal, the last member takes the freed slot
+		int index = member.m_iIndex;
+		m_aMembers.Remove(index);
+		if (index < m_aMembers.Count())
+			m_aMembers[index].m_iIndex = index;
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Drop members not seen for maxAgeMs, checking at most budget of them round-robin
+	//------------------------------------------------------------------------------------------------
+	void Expire(float currentTime, float maxAgeMs, int budget)
+	{
+		int checks = Math.Min(budget, m_aMembers.Count());
+		for (int i = 0; i < checks && m_aMembers.Count() > 0; i++)
+		{
+			if (m_iExpiryCursor >= m_aMembers.Count())
+				m_iExpiryCursor = 0;
+
+			VSC_ClusterMember member = m_aMembers[m_iExpiryCursor];
+			if (currentTime - member.m_fLastSeen >= maxAgeMs)
+				Remove(member.m_sId); // The last member moved into this slot, check it next
+			else
+				m_iExpiryCursor++;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool Contains(string id)
+	{
+		return m_mMembersById.Contains(id);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetMemberCount()
+	{
+		return m_aMembers.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Clusters, including ones emptied since the owner last looked - do not modify
+	//------------------------------------------------------------------------------------------------
+	array<ref VSC_SourceCluster> GetClusters()
+	{
+		return m_aClusters;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Drop an empty cluster once its owner has taken back its histogram contribution
+	//------------------------------------------------------------------------------------------------
+	void RemoveCluster(VSC_SourceCluster cluster)
+	{
+		m_mClustersByCell.Remove(cluster.m_iCell);
+
+		int index = cluster.m_iTrackedIndex;
+		cluster.m_iTrackedIndex = -1;
+		m_aClusters.Remove(index);
+		if (index < m_aClusters.Count())
+			m_aClusters[index].m_iTrackedIndex = index;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Clear()
+	{
+		m_aClusters.Clear();
+		m_mClustersByCell.Clear();
+		m_aMembers.Clear();
+		m_mMembersById.Clear();
+		m_iExpiryCursor = 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected VSC_SourceCluster GetOrCreateCluster(int cell)
+	{
+		VSC_SourceCluster cluster;
+		if (m_mClustersByCell.Find(cell, cluster))
+			return cluster;
+
+		cluster = new VSC_SourceCluster();
+		cluster.m_iCell = cell;
+		cluster.m_sId = "cluster" + cell;
+		cluster.m_iTrackedIndex = m_aClusters.Insert(cluster);
+		m_mClustersByCell.Insert(cell, cluster);
+		return cluster;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Take a member out of its cluster (the cluster stays, possibly empty, until its owner drops it)
+	//------------------------------------------------------------------------------------------------
+	protected void Leave(VSC_ClusterMember member)
+	{
+		VSC_SourceCluster cluster = member.m_Cluster;
+		Contribute(member, -1);
+		cluster.m_iMemberCount--;
+		member.m_Cluster = null;
+
+		// Empty clusters start from exact zeros again, no accumulated rounding drift
+		if (cluster.m_iMemberCount == 0)
+		{
+			cluster.m_vPositionSum = vector.Zero;
+			cluster.m_fIntensitySum = 0.0;
+			cluster.m_iImportantCount = 0;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Add (sign 1) or take back (sign -1) the member's last seen state
+	//------------------------------------------------------------------------------------------------
+	protected void Contribute(VSC_ClusterMember member, int sign)
+	{
+		VSC_SourceCluster cluster = member.m_Cluster;
+		cluster.m_vPositionSum = cluster.m_vPositionSum + member.m_vPosition * sign;
+		cluster.m_fIntensitySum = cluster.m_fIntensitySum + member.m_fIntensity * sign;
+		if (member.m_bImportant)
+			cluster.m_iImportantCount = cluster.m_iImportantCount + sign;
+	}
+}
@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Source Heaps
+// Binary min-heaps of tracked sources. Each source knows its slot in every heap it belongs to,
+// so rescheduling, re-ranking and removal are O(log n) without searching.
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+class VSC_SourceHeap
+{
+	private ref array<VSC_TrackedSoundSource> m_aHeap = {};
+
+	//------------------------------------------------------------------------------------------------
+	// Ordering key, smallest on top
+	//------------------------------------------------------------------------------------------------
+	protected float GetKey(VSC_TrackedSoundSource source);
+
+	//------------------------------------------------------------------------------------------------
+	// Slot of the source in this heap, -1 when not contained
+	//------------------------------------------------------------------------------------------------
+	protected int GetIndex(VSC_TrackedSoundSource source);
+
+	//------------------------------------------------------------------------------------------------
+	protected void SetIndex(VSC_TrackedSoundSource source, int index);
+
+	//------------------------------------------------------------------------------------------------
+	int Count()
+	{
+		return m_aHeap.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Clear()
+	{
+		foreach (VSC_TrackedSoundSource source : m_aHeap)
+		{
+			SetIndex(source, -1);
+		}
+
+		m_aHeap.Clear();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Source with the smallest key, or null when empty
+	//------------------------------------------------------------------------------------------------
+	VSC_TrackedSoundSource Peek()
+	{
+		if (m_aHeap.IsEmpty())
+			return null;
+
+		return m_aHeap[0];
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Insert a source or restore heap order after its key changed
+	//------------------------------------------------------------------------------------------------
+	void Update(VSC_TrackedSoundSource source)
+	{
+		int index = GetIndex(source);
+		if (index < 0)
+		{
+			index = m_aHeap.Count();
+			SetIndex(source, index);
+			m_aHeap.Insert(source);
+		}
+
+		index = SiftUp(index);
+		SiftDown(index);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Remove(VSC_TrackedSoundSource source)
+	{
+		int index = GetIndex(source);
+		if (index < 0)
+			return;
+
+		SetIndex(source, -1);
+
+		int last = m_aHeap.Count() - 1;
+		if (index == last)
+		{
+			m_aHeap.Remove(last);
+			return;
+		}
+
+		VSC_TrackedSoundSource moved = m_aHeap[last];
+		m_aHeap.Set(index, moved);
+		SetIndex(moved, index);
+		m_aHeap.Remove(last);
+
+		index = SiftUp(index);
+		SiftDown(index);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected int SiftUp(int index)
+	{
+		while (index > 0)
+		{
+			int parent = (index - 1) / 2;
+			if (GetKey(m_aHeap[parent]) <= GetKey(m_aHeap[index]))
+				break;
+
+			Swap(index, parent);
+			index = parent;
+		}
+
+		return index;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void SiftDown(int index)
+	{
+		int count = m_aHeap.Count();
+		while (true)
+		{
+			int smallest = index;
+			int left = index * 2 + 1;
+			int right = left + 1;
+
+			if (left < count && GetKey(m_aHeap[left]) < GetKey(m_aHeap[smallest]))
+				smallest = left;
+
+			if (right < count && GetKey(m_aHeap[right]) < GetKey(m_aHeap[smallest]))
+				smallest = right;
+
+			if (smallest == index)
+				return;
+
+			Swap(index, smallest);
+			index = smallest;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Swap(int a, int b)
+	{
+		VSC_TrackedSoundSource sourceA = m_aHeap[a];
+		VSC_TrackedSoundSource sourceB = m_aHeap[b];
+		m_aHeap.Set(a, sourceB);
+		m_aHeap.Set(b, sourceA);
+		SetIndex(sourceA, b);
+		SetIndex(sourceB, a);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Tracked sources ordered by next refresh time, the source due soonest on top
+//------------------------------------------------------------------------------------------------
+class VSC_RefreshQueue : VSC_SourceHeap
+{
+	//------------------------------------------------------------------------------------------------
+	void Schedule(VSC_TrackedSoundSource source, float refreshTime)
+	{
+		source.m_fNextRefreshTime = refreshTime;
+		Update(source);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override protected float GetKey(VSC_TrackedSoundSource source)
+	{
+		return source.m_fNextRefreshTime;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override protected int GetIndex(VSC_TrackedSoundSource source)
+	{
+		return source.m_iQueueIndex;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override protected void SetIndex(VSC_TrackedSoundSource source, int index)
+	{
+		source.m_iQueueIndex = index;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Tracked sources ordered by importance, the weakest (first to evict) on top
+//------------------------------------------------------------------------------------------------
+class VSC_ImportanceHeap : VSC_SourceHeap
+{
+	//------------------------------------------------------------------------------------------------
+	override protected float GetKey(VSC_TrackedSoundSource source)
+	{
+		return source.m_fImportance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override protected int GetIndex(VSC_TrackedSoundSource source)
+	{
+		return source.m_iRankIndex;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override protected void SetIndex(VSC_TrackedSoundSource source, int index)
+	{
+		source.m_iRankIndex = index;
+	}
+}
@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Stage Statistics
+// Accumulates per-stage processing time for benchmarks, replays and client telemetry. Runs are
+// timed in whole milliseconds, so a single run says little; telemetry reads the totals once per
+// window of ticks instead (see VSC_WindowCostHistogram).
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+enum EVSC_Stage
+{
+	PROTECTION,
+	TRACKING,
+	FILTERING,
+	COUNT
+}
+
+class VSC_StageStats
+{
+	private ref array<int> m_aTotalMs = {};
+	private ref array<int> m_aCalls = {};
+
+	//------------------------------------------------------------------------------------------------
+	void VSC_StageStats()
+	{
+		Reset();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Reset()
+	{
+		m_aTotalMs.Clear();
+		m_aCalls.Clear();
+		for (int i = 0; i < EVSC_Stage.COUNT; i++)
+		{
+			m_aTotalMs.Insert(0);
+			m_aCalls.Insert(0);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Record one stage run that started at startTick (System.GetTickCount)
+	// Tick counts are in whole milliseconds; over many calls the truncation averages out,
+	// so totals and averages are only meaningful across a long run
+	//------------------------------------------------------------------------------------------------
+	void Add(EVSC_Stage stage, int startTick)
+	{
+		Record(stage, System.GetTickCount() - startTick);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Record one stage run of a known length
+	//------------------------------------------------------------------------------------------------
+	void Record(EVSC_Stage stage, int elapsedMs)
+	{
+		m_aTotalMs[stage] = m_aTotalMs[stage] + elapsedMs;
+		m_aCalls[stage] = m_aCalls[stage] + 1;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Add another set of runs (merging clients or intervals)
+	//------------------------------------------------------------------------------------------------
+	void Merge(VSC_StageStats other)
+	{
+		for (int stage = 0; stage < EVSC_Stage.COUNT; stage++)
+		{
+			m_aTotalMs[stage] = m_aTotalMs[stage] + other.m_aTotalMs[stage];
+			m_aCalls[stage] = m_aCalls[stage] + other.m_aCalls[stage];
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Take away runs recorded up to an earlier copy of these stats (not taken before a Reset),
+	// leaving the runs since
+	//------------------------------------------------------------------------------------------------
+	void Subtract(VSC_StageStats earlier)
+	{
+		for (int stage = 0; stage < EVSC_Stage.COUNT; stage++)
+		{
+			m_aTotalMs[stage] = Math.Max(m_aTotalMs[stage] - earlier.m_aTotalMs[stage], 0);
+			m_aCalls[stage] = Math.Max(m_aCalls[stage] - earlier.m_aCalls[stage], 0);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Replace one stage with counts received from elsewhere (telemetry reports)
+	//------------------------------------------------------------------------------------------------
+	void SetStage(EVSC_Stage stage, int calls, int totalMs)
+	{
+		m_aCalls[stage] = calls;
+		m_aTotalMs[stage] = totalMs;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void CopyFrom(VSC_StageStats other)
+	{
+		Reset();
+		Merge(other);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetCalls(EVSC_Stage stage)
+	{
+		return m_aCalls[stage];
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetTotalMs(EVSC_Stage stage)
+	{
+		return m_aTotalMs[stage];
+	}
+
+	//------------------------------------------------------------------------------------------------
+	float GetAverageMicroseconds(EVSC_Stage stage)
+	{
+		if (m_aCalls[stage] == 0)
+			return 0.0;
+
+		return m_aTotalMs[stage] * 1000.0 / m_aCalls[stage];
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static string GetStageName(EVSC_Stage stage)
+	{
+		return typename.EnumToString(EVSC_Stage, stage);
+	}
+}
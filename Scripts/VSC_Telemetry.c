@@ -0,0 +1,568 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Fleet Telemetry
+// Clients summarise what VSC cost them and did since their last report: per-stage run totals and
+// the distribution of each stage's cost per second of ticks, tracked and clustered source counts,
+// dampenings and perception writes. Every 30-60 s (jittered, so a full server does not report in
+// step) the summary goes to the server as one small string through the sender's own player
+// controller. The server merges the reports of the whole session and rewrites
+// $profile:VSC/telemetry_<session start>.json, with p50/p95/p99 of the window cost per stage,
+// every few minutes and on shutdown.
+// Off unless the server enables it (see VSC_HeadgearManagerComponent).
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------------------------
+// How many whole milliseconds each stage cost over one WINDOW_MS of ticks. A single run is timed
+// by System.GetTickCount and almost always reads 0 ms, but a second's worth of runs adds up to a
+// total that tracks how busy the stage was, so percentiles of the window totals are meaningful.
+//------------------------------------------------------------------------------------------------
+class VSC_WindowCostHistogram
+{
+	static const int WINDOW_MS = 1000;
+	static const int BUCKET_COUNT = 64; // 0..62 ms per window, the last bucket holds every costlier window
+
+	private ref array<int> m_aCounts = {}; // Stage x BUCKET_COUNT window counts
+
+	//------------------------------------------------------------------------------------------------
+	void VSC_WindowCostHistogram()
+	{
+		Clear();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Clear()
+	{
+		m_aCounts.Clear();
+		m_aCounts.Resize(EVSC_Stage.COUNT * BUCKET_COUNT);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Record one window in which the stage cost costMs
+	//------------------------------------------------------------------------------------------------
+	void Record(EVSC_Stage stage, int costMs)
+	{
+		AddCount(stage, Math.ClampInt(costMs, 0, BUCKET_COUNT - 1), 1);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void AddCount(EVSC_Stage stage, int bucket, int count)
+	{
+		int index = stage * BUCKET_COUNT + bucket;
+		m_aCounts[index] = m_aCounts[index] + count;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Windows in which the stage cost ms (BUCKET_COUNT - 1 = that much or more)
+	//------------------------------------------------------------------------------------------------
+	int GetCount(EVSC_Stage stage, int ms)
+	{
+		return m_aCounts[stage * BUCKET_COUNT + ms];
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetWindowCount(EVSC_Stage stage)
+	{
+		int windows = 0;
+		for (int ms = 0; ms < BUCKET_COUNT; ms++)
+		{
+			windows += GetCount(stage, ms);
+		}
+
+		return windows;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Smallest window cost that fraction (0..1) of the stage's windows did not exceed
+	//------------------------------------------------------------------------------------------------
+	int GetPercentileMs(EVSC_Stage stage, float fraction)
+	{
+		int windows = GetWindowCount(stage);
+		if (windows == 0)
+			return 0;
+
+		int needed = Math.Max(Math.Ceil(windows * fraction), 1);
+		int seen = 0;
+		for (int ms = 0; ms < BUCKET_COUNT - 1; ms++)
+		{
+			seen += GetCount(stage, ms);
+			if (seen >= needed)
+				return ms;
+		}
+
+		return BUCKET_COUNT - 1;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Merge(VSC_WindowCostHistogram other)
+	{
+		for (int i = 0; i < m_aCounts.Count(); i++)
+		{
+			m_aCounts[i] = m_aCounts[i] + other.m_aCounts[i];
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// One client's summary of a report interval
+//------------------------------------------------------------------------------------------------
+class VSC_TelemetryReport
+{
+	static const int VERSION = 2;
+	private const int HEADER_FIELDS = 9; // Version and the counters below, then one field per stage
+
+	int m_iIntervalMs;
+	int m_iTicks;
+	int m_iTrackedSum; // Tracked sources summed over ticks
+	int m_iTrackedMax;
+	int m_iClusteredSum; // Clustered sources summed over ticks
+	int m_iClusteredMax;
+	int m_iDampenings;
+	int m_iPerceptionWrites;
+	ref VSC_StageStats m_Stats = new VSC_StageStats();
+	ref VSC_WindowCostHistogram m_WindowCost = new VSC_WindowCostHistogram();
+
+	//------------------------------------------------------------------------------------------------
+	// Comma separated counters, each stage as "calls totalMs windowCost..." with trailing zeros cut
+	//------------------------------------------------------------------------------------------------
+	string Encode()
+	{
+		string encoded = string.Format("%1,%2,%3,%4,%5,%6,%7,%8,%9", VERSION, m_iIntervalMs, m_iTicks, m_iTrackedSum, m_iTrackedMax, m_iClusteredSum, m_iClusteredMax, m_iDampenings, m_iPerceptionWrites);
+		for (int stage = 0; stage < EVSC_Stage.COUNT; stage++)
+		{
+			int last = VSC_WindowCostHistogram.BUCKET_COUNT - 1;
+			while (last >= 0 && m_WindowCost.GetCount(stage, last) == 0)
+			{
+				last--;
+			}
+
+			encoded += string.Format(",%1 %2", m_Stats.GetCalls(stage), m_Stats.GetTotalMs(stage));
+			for (int ms = 0; ms <= last; ms++)
+			{
+				encoded += " " + m_WindowCost.GetCount(stage, ms);
+			}
+		}
+
+		return encoded;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Read an encoded report, false if it is malformed or from another version
+	//------------------------------------------------------------------------------------------------
+	bool Decode(string encoded)
+	{
+		array<string> fields = {};
+		encoded.Split(",", fields, false);
+		if (fields.Count() != HEADER_FIELDS + EVSC_Stage.COUNT || fields[0].ToInt() != VERSION)
+			return false;
+
+		m_iIntervalMs = fields[1].ToInt();
+		m_iTicks = fields[2].ToInt();
+		m_iTrackedSum = fields[3].ToInt();
+		m_iTrackedMax = fields[4].ToInt();
+		m_iClusteredSum = fields[5].ToInt();
+		m_iClusteredMax = fields[6].ToInt();
+		m_iDampenings = fields[7].ToInt();
+		m_iPerceptionWrites = fields[8].ToInt();
+		if (m_iIntervalMs < 0 || m_iTicks < 0 || m_iTrackedSum < 0 || m_iClusteredSum < 0 || m_iDampenings < 0 || m_iPerceptionWrites < 0)
+			return false;
+
+		m_Stats.Reset();
+		m_WindowCost.Clear();
+		array<string> values = {};
+		for (int stage = 0; stage < EVSC_Stage.COUNT; stage++)
+		{
+			values.Clear();
+			fields[HEADER_FIELDS + stage].Split(" ", values, true);
+			if (values.Count() < 2 || values.Count() > VSC_WindowCostHistogram.BUCKET_COUNT + 2)
+				return false;
+
+			int calls = values[0].ToInt();
+			int totalMs = values[1].ToInt();
+			if (calls < 0 || totalMs < 0)
+				return false;
+
+			m_Stats.SetStage(stage, calls, totalMs);
+			for (int i = 2; i < values.Count(); i++)
+			{
+				int count = values[i].ToInt();
+				if (count < 0)
+					return false;
+
+				m_WindowCost.AddCount(stage, i - 2, count);
+			}
+		}
+
+		return true;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Client side: collects one report interval from the local pipeline
+//------------------------------------------------------------------------------------------------
+class VSC_TelemetrySampler
+{
+	static const int MIN_REPORT_INTERVAL_MS = 30000;
+	static const int MAX_REPORT_INTERVAL_MS = 60000;
+
+	private ref VSC_StageStats m_Snapshot = new VSC_StageStats(); // Stage stats at the last report
+	private float m_fIntervalStart;
+	private ref VSC_TelemetryReport m_Report = new VSC_TelemetryReport();
+
+	// Cost window, recorded into the report it closes in
+	private ref VSC_StageStats m_WindowSnapshot = new VSC_StageStats(); // Stage stats at the window start
+	private float m_fWindowStart = -1.0; // -1 until the next tick opens a window
+
+	// Dampening and write counters belong to the current protection stage and output and restart
+	// with new ones - a drop means a restart
+	private int m_iLastDampeningCount;
+	private int m_iLastWriteCount;
+
+	//------------------------------------------------------------------------------------------------
+	// Delay until the next report, jittered across the report window
+	//------------------------------------------------------------------------------------------------
+	static int GetNextReportDelay()
+	{
+		return Math.RandomIntInclusive(MIN_REPORT_INTERVAL_MS, MAX_REPORT_INTERVAL_MS);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Start an interval from the stage stats as they are now
+	//------------------------------------------------------------------------------------------------
+	void Begin(VSC_StageStats stats, float currentTime)
+	{
+		m_Snapshot.CopyFrom(stats);
+		m_fIntervalStart = currentTime;
+		m_Report = new VSC_TelemetryReport();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// The stage stats were reset, count everything recorded from now on
+	//------------------------------------------------------------------------------------------------
+	void OnStatsReset()
+	{
+		m_Snapshot.Reset();
+		m_fWindowStart = -1.0; // The open window lost its runs
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Once per tick, after the pipeline ran on stats
+	//------------------------------------------------------------------------------------------------
+	void Sample(VSC_Pipeline pipeline, VSC_StageStats stats)
+	{
+		m_Report.m_iTicks++;
+		SampleWindow(stats, pipeline.GetClock().GetMs());
+
+		VSC_BOSSAProcessor bossa = pipeline.GetBOSSA();
+		if (bossa)
+		{
+			int tracked = bossa.GetTrackedSourceCount();
+			int clustered = bossa.GetClusteredSourceCount();
+			m_Report.m_iTrackedSum += tracked;
+			m_Report.m_iTrackedMax = Math.Max(m_Report.m_iTrackedMax, tracked);
+			m_Report.m_iClusteredSum += clustered;
+			m_Report.m_iClusteredMax = Math.Max(m_Report.m_iClusteredMax, clustered);
+		}
+
+		VSC_ProtectionProcessor protection = pipeline.GetProtection();
+		if (protection)
+			m_Report.m_iDampenings += TakeIncrease(protection.GetDampeningCount(), m_iLastDampeningCount);
+
+		VSC_HearingOutput output = pipeline.GetOutput();
+		if (output)
+			m_Report.m_iPerceptionWrites += TakeIncrease(output.GetWriteCount(), m_iLastWriteCount);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Finish the interval and start the next one
+	//------------------------------------------------------------------------------------------------
+	VSC_TelemetryReport TakeReport(VSC_StageStats stats, float currentTime)
+	{
+		VSC_TelemetryReport report = m_Report;
+		report.m_iIntervalMs = Math.Max(currentTime - m_fIntervalStart, 0);
+		report.m_Stats.CopyFrom(stats);
+		report.m_Stats.Subtract(m_Snapshot);
+
+		Begin(stats, currentTime);
+		return report;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Close the cost window once it spans WINDOW_MS; a window stretched past twice that (ticks
+	// stopped while suspended) is dropped rather than read as a cheap one
+	//------------------------------------------------------------------------------------------------
+	protected void SampleWindow(VSC_StageStats stats, float currentTime)
+	{
+		float elapsed = currentTime - m_fWindowStart;
+		if (m_fWindowStart >= 0.0 && elapsed < VSC_WindowCostHistogram.WINDOW_MS)
+			return;
+
+		if (m_fWindowStart >= 0.0 && elapsed < VSC_WindowCostHistogram.WINDOW_MS * 2)
+		{
+			for (int stage = 0; stage < EVSC_Stage.COUNT; stage++)
+			{
+				m_Report.m_WindowCost.Record(stage, stats.GetTotalMs(stage) - m_WindowSnapshot.GetTotalMs(stage));
+			}
+		}
+
+		m_WindowSnapshot.CopyFrom(stats);
+		m_fWindowStart = currentTime;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected int TakeIncrease(int count, inout int lastCount)
+	{
+		int increase = count - lastCount;
+		if (increase < 0)
+			increase = count;
+
+		lastCount = count;
+		return increase;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Server side: merges the session's reports and writes them out as JSON
+//------------------------------------------------------------------------------------------------
+class VSC_TelemetryAggregator
+{
+	private static ref VSC_TelemetryAggregator s_Instance;
+
+	static const string FILE_PREFIX = "$profile:VSC/telemetry_";
+	private const int WRITE_INTERVAL_MS = 300000;
+	private const float MIN_REPORT_SPACING_MS = 20000.0; // Faster reports from one player are dropped
+
+	private int m_iSessionStart = System.GetUnixTime();
+	private ref map<int, float> m_mLastReportTime = new map<int, float>(); // Player ID -> world ms
+	private ref VSC_StageStats m_Stats = new VSC_StageStats();
+	private ref VSC_WindowCostHistogram m_WindowCost = new VSC_WindowCostHistogram();
+	private int m_iReports;
+	private int m_iRejected;
+	private float m_fClientMs; // Summed report intervals
+	private int m_iTicks;
+	private float m_fTrackedSum;
+	private int m_iTrackedMax;
+	private float m_fClusteredSum;
+	private int m_iClusteredMax;
+	private int m_iDampenings;
+	private int m_iPerceptionWrites;
+	private bool m_bChanged;
+
+	//------------------------------------------------------------------------------------------------
+	// Create the server singleton (no-op on clients connected to a server)
+	//------------------------------------------------------------------------------------------------
+	static VSC_TelemetryAggregator Create()
+	{
+		if (RplSession.Mode() == RplMode.Client)
+			return null;
+
+		if (!s_Instance)
+		{
+			s_Instance = new VSC_TelemetryAggregator();
+			GetGame().GetCallqueue(CALL_CATEGORY_SYSTEM).CallLater(s_Instance.WriteIfChanged, WRITE_INTERVAL_MS, true);
+
+#ifndef VSC_NO_LOGGING
+			Print("[VSC Telemetry] Collecting client reports into " + s_Instance.GetPath(), LogLevel.NORMAL);
+#endif
+		}
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static VSC_TelemetryAggregator GetInstance()
+	{
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Write what was collected and stop
+	//------------------------------------------------------------------------------------------------
+	static void Destroy()
+	{
+		if (!s_Instance)
+			return;
+
+		GetGame().GetCallqueue(CALL_CATEGORY_SYSTEM).Remove(s_Instance.WriteIfChanged);
+		s_Instance.WriteIfChanged();
+		s_Instance = null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// A client's encoded report arrived (ignored while telemetry is off)
+	//------------------------------------------------------------------------------------------------
+	static void Receive(int playerId, string encoded)
+	{
+		if (!s_Instance)
+			return;
+
+		VSC_TelemetryReport report = new VSC_TelemetryReport();
+		if (!report.Decode(encoded))
+		{
+			s_Instance.m_iRejected++;
+			return;
+		}
+
+		s_Instance.Add(playerId, report, VSC_Clock.SampleWorld().GetMs());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Merge a report, false if the player reported too recently
+	//------------------------------------------------------------------------------------------------
+	bool Add(int playerId, VSC_TelemetryReport report, float currentTime)
+	{
+		float lastTime;
+		if (m_mLastReportTime.Find(playerId, lastTime) && currentTime - lastTime < MIN_REPORT_SPACING_MS)
+		{
+			m_iRejected++;
+			return false;
+		}
+
+		m_mLastReportTime.Set(playerId, currentTime);
+		m_Stats.Merge(report.m_Stats);
+		m_WindowCost.Merge(report.m_WindowCost);
+		m_iReports++;
+		m_fClientMs += report.m_iIntervalMs;
+		m_iTicks += report.m_iTicks;
+		m_fTrackedSum += report.m_iTrackedSum;
+		m_iTrackedMax = Math.Max(m_iTrackedMax, report.m_iTrackedMax);
+		m_fClusteredSum += report.m_iClusteredSum;
+		m_iClusteredMax = Math.Max(m_iClusteredMax, report.m_iClusteredMax);
+		m_iDampenings += report.m_iDampenings;
+		m_iPerceptionWrites += report.m_iPerceptionWrites;
+		m_bChanged = true;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Merged stage runs of every report so far
+	//------------------------------------------------------------------------------------------------
+	VSC_StageStats GetStageStats()
+	{
+		return m_Stats;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Merged cost windows of every report so far
+	//------------------------------------------------------------------------------------------------
+	VSC_WindowCostHistogram GetWindowCost()
+	{
+		return m_WindowCost;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetReportCount()
+	{
+		return m_iReports;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetRejectedCount()
+	{
+		return m_iRejected;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	string GetPath()
+	{
+		return FILE_PREFIX + m_iSessionStart + ".json";
+	}
+
+	//------------------------------------------------------------------------------------------------
+	string ToJson()
+	{
+		string json = "{\n";
+		json += string.Format("\t\"version\": %1,\n", VSC_TelemetryReport.VERSION);
+		json += string.Format("\t\"sessionStart\": %1,\n", m_iSessionStart);
+		json += string.Format("\t\"writtenAt\": %1,\n", System.GetUnixTime());
+		json += string.Format("\t\"players\": %1,\n", m_mLastReportTime.Count());
+		json += string.Format("\t\"reports\": %1,\n", m_iReports);
+		json += string.Format("\t\"rejectedReports\": %1,\n", m_iRejected);
+		json += string.Format("\t\"clientMinutes\": %1,\n", (m_fClientMs / 60000.0).ToString(-1, 1));
+		json += string.Format("\t\"ticks\": %1,\n", m_iTicks);
+
+		json += "\t\"stages\": {\n";
+		for (int stage = 0; stage < EVSC_Stage.COUNT; stage++)
+		{
+			string histogram;
+			for (int ms = 0; ms < VSC_WindowCostHistogram.BUCKET_COUNT; ms++)
+			{
+				if (ms > 0)
+					histogram += ", ";
+
+				histogram += m_WindowCost.GetCount(stage, ms).ToString();
+			}
+
+			// Window percentiles are whole ms spent in the stage per second of ticks
+			json += string.Format("\t\t\"%1\": { \"calls\": %2, \"totalMs\": %3, \"avgUs\": %4, ", VSC_StageStats.GetStageName(stage), m_Stats.GetCalls(stage), m_Stats.GetTotalMs(stage), m_Stats.GetAverageMicroseconds(stage).ToString(-1, 1));
+			json += string.Format("\"windows\": %1, \"p50MsPerSecond\": %2, \"p95MsPerSecond\": %3, \"p99MsPerSecond\": %4, \"windowHistogramMs\": [%5] }", m_WindowCost.GetWindowCount(stage), m_WindowCost.GetPercentileMs(stage, 0.5), m_WindowCost.GetPercentileMs(stage, 0.95), m_WindowCost.GetPercentileMs(stage, 0.99), histogram);
+			if (stage < EVSC_Stage.COUNT - 1)
+				json += ",";
+
+			json += "\n";
+		}
+		json += "\t},\n";
+
+		json += string.Format("\t\"trackedSources\": { \"mean\": %1, \"max\": %2 },\n", GetMean(m_fTrackedSum).ToString(-1, 2), m_iTrackedMax);
+		json += string.Format("\t\"clusteredSources\": { \"mean\": %1, \"max\": %2 },\n", GetMean(m_fClusteredSum).ToString(-1, 2), m_iClusteredMax);
+		json += string.Format("\t\"dampenings\": %1,\n", m_iDampenings);
+		json += string.Format("\t\"perceptionWrites\": %1\n", m_iPerceptionWrites);
+		json += "}\n";
+		return json;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Rewrite the session file if reports arrived since the last write
+	//------------------------------------------------------------------------------------------------
+	protected void WriteIfChanged()
+	{
+		if (!m_bChanged)
+			return;
+
+		FileIO.MakeDirectory(VSC_Trace.DIRECTORY);
+		FileHandle file = FileIO.OpenFile(GetPath(), FileMode.WRITE);
+		if (!file)
+		{
+			Print("[VSC Telemetry] Could not write " + GetPath(), LogLevel.WARNING);
+			return;
+		}
+
+		file.Write(ToJson());
+		file.Close();
+		m_bChanged = false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Per-tick mean of a sum over all reported ticks
+	//------------------------------------------------------------------------------------------------
+	protected float GetMean(float sum)
+	{
+		if (m_iTicks == 0)
+			return 0.0;
+
+		return sum / m_iTicks;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Reports travel through the sender's own player controller, the one replicated object a client
+// may call the server on
+//------------------------------------------------------------------------------------------------
+modded class SCR_PlayerController
+{
+	//------------------------------------------------------------------------------------------------
+	void VSC_SendTelemetry(string report)
+	{
+		// A listen server's host is the server already
+		if (Replication.IsServer())
+			VSC_TelemetryAggregator.Receive(GetPlayerId(), report);
+		else
+			Rpc(RpcAsk_VSC_Telemetry, report);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[RplRpc(RplChannel.Reliable, RplRcver.Server)]
+	protected void RpcAsk_VSC_Telemetry(string report)
+	{
+		VSC_TelemetryAggregator.Receive(GetPlayerId(), report);
+	}
+}
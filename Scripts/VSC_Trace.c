@@ -0,0 +1,328 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Input Traces
+// Compact binary record of VSC inputs (listener transform, sources, weapon fire and explosions
+// per tick) for deterministic offline replay. All values are 4-byte ints/floats.
+//
+// Layout: header  = MAGIC, VERSION, original auditory range
+//         frame   = time, listener origin (3), listener forward (3),
+//                   enclosure, openness, hard surfaces (version 2+),
+//                   source count, {id, position (3), class flags} ...,
+//                   weapon fire count, {position (3), direction (3), range scale,
+//                   directivity (version 3+)} ...,
+//                   explosion count, {position (3), time (version 4+)} ...
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+class VSC_Trace
+{
+	static const int MAGIC = 0x54435356; // "VSCT"
+	static const int VERSION = 4;
+	static const int MIN_VERSION = 1; // Version 1 traces replay as open terrain, before 3 all shots as the reference report, before 4 explosions at their frame time
+	static const string DIRECTORY = "$profile:VSC";
+	static const string EXTENSION = ".vsctrace";
+}
+
+//------------------------------------------------------------------------------------------------
+class VSC_TraceWriter
+{
+	private FileHandle m_File;
+	private ref map<string, int> m_mIdIndex = new map<string, int>(); // Source ids interned as ints
+
+	//------------------------------------------------------------------------------------------------
+	bool Open(string path, float originalAuditoryRange)
+	{
+		m_File = FileIO.OpenFile(path, FileMode.WRITE);
+		if (!m_File)
+			return false;
+
+		WriteInt(VSC_Trace.MAGIC);
+		WriteInt(VSC_Trace.VERSION);
+		WriteFloat(originalAuditoryRange);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Close()
+	{
+		if (m_File)
+			m_File.Close();
+
+		m_File = null;
+		m_mIdIndex.Clear();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void WriteFrame(VSC_InputFrame frame)
+	{
+		WriteFloat(frame.m_fTime);
+		WriteVector(frame.m_vListenerOrigin);
+		WriteVector(frame.m_vListenerForward);
+		WriteFloat(frame.m_Acoustics.m_fEnclosure);
+		WriteFloat(frame.m_Acoustics.m_fOpenness);
+		WriteFloat(frame.m_Acoustics.m_fHardSurfaces);
+
+		WriteInt(frame.m_aSources.Count());
+		foreach (VSC_SourceSample sample : frame.m_aSources)
+		{
+			int index;
+			if (!m_mIdIndex.Find(sample.m_sId, index))
+			{
+				index = m_mIdIndex.Count();
+				m_mIdIndex.Insert(sample.m_sId, index);
+			}
+
+			WriteInt(index);
+			WriteVector(sample.m_vPosition);
+			WriteInt(sample.m_iClassFlags);
+		}
+
+		WriteInt(frame.m_aWeaponFire.Count());
+		foreach (VSC_WeaponFire fire : frame.m_aWeaponFire)
+		{
+			WriteVector(fire.m_vPosition);
+			WriteVector(fire.m_vDirection);
+			WriteFloat(fire.m_fRangeScale);
+			WriteFloat(fire.m_fDirectivity);
+		}
+
+		WriteInt(frame.m_aExplosions.Count());
+		foreach (int i, vector explosionPos : frame.m_aExplosions)
+		{
+			WriteVector(explosionPos);
+			WriteFloat(frame.m_aExplosionTimes[i]);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void WriteInt(int value)
+	{
+		m_File.Write(value, 4);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void WriteFloat(float value)
+	{
+		m_File.Write(value, 4);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void WriteVector(vector value)
+	{
+		WriteFloat(value[0]);
+		WriteFloat(value[1]);
+		WriteFloat(value[2]);
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+class VSC_TraceReader
+{
+	private FileHandle m_File;
+	private int m_iVersion;
+	private float m_fOriginalAuditoryRange;
+
+	//------------------------------------------------------------------------------------------------
+	bool Open(string path)
+	{
+		m_File = FileIO.OpenFile(path, FileMode.READ);
+		if (!m_File)
+			return false;
+
+		int magic;
+		if (!ReadInt(magic) || magic != VSC_Trace.MAGIC || !ReadInt(m_iVersion) || m_iVersion < VSC_Trace.MIN_VERSION || m_iVersion > VSC_Trace.VERSION)
+		{
+			Print("[VSC Trace] Unsupported trace file: " + path, LogLevel.ERROR);
+			Close();
+			return false;
+		}
+
+		return ReadFloat(m_fOriginalAuditoryRange);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Close()
+	{
+		if (m_File)
+			m_File.Close();
+
+		m_File = null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	float GetOriginalAuditoryRange()
+	{
+		return m_fOriginalAuditoryRange;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Read the next frame into the given (reused) frame, false at end of trace
+	//------------------------------------------------------------------------------------------------
+	bool ReadFrame(notnull VSC_InputFrame frame)
+	{
+		frame.Clear();
+
+		if (!ReadFloat(frame.m_fTime))
+			return false;
+
+		ReadVector(frame.m_vListenerOrigin);
+		ReadVector(frame.m_vListenerForward);
+
+		if (m_iVersion >= 2)
+		{
+			ReadFloat(frame.m_Acoustics.m_fEnclosure);
+			ReadFloat(frame.m_Acoustics.m_fOpenness);
+			ReadFloat(frame.m_Acoustics.m_fHardSurfaces);
+		}
+
+		int count;
+		ReadInt(count);
+		for (int i = 0; i < count; i++)
+		{
+			VSC_SourceSample sample = new VSC_SourceSample();
+			int index;
+			ReadInt(index);
+			sample.m_sId = index.ToString();
+			ReadVector(sample.m_vPosition);
+			ReadInt(sample.m_iClassFlags);
+			frame.m_aSources.Insert(sample);
+		}
+
+		vector position;
+		ReadInt(count);
+		for (int j = 0; j < count; j++)
+		{
+			VSC_WeaponFire fire = new VSC_WeaponFire();
+			ReadVector(fire.m_vPosition);
+			if (m_iVersion >= 3)
+			{
+				ReadVector(fire.m_vDirection);
+				ReadFloat(fire.m_fRangeScale);
+				ReadFloat(fire.m_fDirectivity);
+			}
+
+			frame.m_aWeaponFire.Insert(fire);
+		}
+
+		if (!ReadInt(count))
+			return false;
+
+		// Before version 4 explosions are handled at the frame's time
+		float explosionTime = frame.m_fTime;
+		for (int k = 0; k < count; k++)
+		{
+			ReadVector(position);
+			if (m_iVersion >= 4)
+				ReadFloat(explosionTime);
+
+			frame.m_aExplosions.Insert(position);
+			frame.m_aExplosionTimes.Insert(explosionTime);
+		}
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool ReadInt(out int value)
+	{
+		return m_File.Read(value, 4) == 4;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool ReadFloat(out float value)
+	{
+		return m_File.Read(value, 4) == 4;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool ReadVector(out vector value)
+	{
+		float x, y, z;
+		bool ok = ReadFloat(x) && ReadFloat(y) && ReadFloat(z);
+		value = Vector(x, y, z);
+		return ok;
+	}
+}
+
+#ifndef VSC_SERVER_LITE
+//------------------------------------------------------------------------------------------------
+// Captures live input frames and writes them to a trace
+// Sources are captured within a fixed radius every tick (independent of the tuning profile),
+// so a trace can be replayed against any profile
+//------------------------------------------------------------------------------------------------
+class VSC_TraceRecorder
+{
+	private const float CAPTURE_RADIUS = 200.0;
+	private const float WEAPON_CAPTURE_RANGE = 50.0; // Covers the loudest report at the default trigger range
+
+	private ref VSC_TraceWriter m_Writer;
+	private ref VSC_InputFrame m_Frame = new VSC_InputFrame();
+	private ref array<vector> m_aPendingExplosions = {};
+	private ref array<float> m_aPendingExplosionTimes = {};
+
+	//------------------------------------------------------------------------------------------------
+	bool Start(string name, float originalAuditoryRange)
+	{
+		FileIO.MakeDirectory(VSC_Trace.DIRECTORY);
+		string path = VSC_Trace.DIRECTORY + "/" + name + VSC_Trace.EXTENSION;
+
+		m_Writer = new VSC_TraceWriter();
+		if (!m_Writer.Open(path, originalAuditoryRange))
+		{
+			Print("[VSC Trace] Failed to open trace for writing: " + path, LogLevel.ERROR);
+			m_Writer = null;
+			return false;
+		}
+
+		Print("[VSC Trace] Recording to " + path, LogLevel.NORMAL);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Stop()
+	{
+		if (!m_Writer)
+			return;
+
+		m_Writer.Close();
+		m_Writer = null;
+		Print("[VSC Trace] Recording stopped", LogLevel.NORMAL);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void AddExplosion(vector position, float time)
+	{
+		m_aPendingExplosions.Insert(position);
+		m_aPendingExplosionTimes.Insert(time);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Sample the world into a frame, write it and return it for processing this tick
+	//------------------------------------------------------------------------------------------------
+	VSC_InputFrame CaptureFrame(notnull VSC_WorldInput input)
+	{
+		m_Frame.Clear();
+		m_Frame.m_fTime = input.GetTime();
+		m_Frame.m_vListenerOrigin = input.GetListenerOrigin();
+		m_Frame.m_vListenerForward = input.GetListenerForward();
+
+		VSC_Acoustics acoustics = input.GetListenerAcoustics();
+		m_Frame.m_Acoustics.Set(acoustics.m_fEnclosure, acoustics.m_fOpenness, acoustics.m_fHardSurfaces);
+
+		input.QuerySources(CAPTURE_RADIUS, m_Frame.m_aSources);
+		input.CollectWeaponFire(WEAPON_CAPTURE_RANGE, m_Frame.m_aWeaponFire);
+
+		foreach (int i, vector explosionPos : m_aPendingExplosions)
+		{
+			m_Frame.m_aExplosions.Insert(explosionPos);
+			m_Frame.m_aExplosionTimes.Insert(m_aPendingExplosionTimes[i]);
+		}
+		m_aPendingExplosions.Clear();
+		m_aPendingExplosionTimes.Clear();
+
+		if (m_Writer)
+			m_Writer.WriteFrame(m_Frame);
+
+		return m_Frame;
+	}
+}
+#endif
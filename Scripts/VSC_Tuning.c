@@ -0,0 +1,290 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Runtime Tuning
+// Reads and edits tuning while the game runs. Every float, int and bool field of a profile is a
+// parameter, named without its member prefix (m_fBoostMultiplier -> BoostMultiplier). Edits are
+// made on private copies owned by VSC_LocalController and swapped in on its next frame - the
+// shared profiles from VSC_ProfileRegistry are never modified.
+// Chat command (client side, admins only outside diag builds):
+//   #vsc [list]                 all parameters and their current values
+//   #vsc get <key>              one parameter, e.g. bossa.AttentionConeAngle
+//   #vsc set <key> <value> ...  one or more parameters, applied together on the next frame
+//   #vsc reset                  back to the headgear profiles and default tick interval
+//   #vsc cost                   measured time per stage since the last change
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+class VSC_Tuning
+{
+	//------------------------------------------------------------------------------------------------
+	// Parameter name of a member variable (prefix m_ and the type letter removed)
+	//------------------------------------------------------------------------------------------------
+	static string GetParameterName(string variableName)
+	{
+		if (variableName.Length() > 3 && variableName.StartsWith("m_"))
+			return variableName.Substring(3, variableName.Length() - 3);
+
+		return variableName;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Names of all tunable parameters of a profile
+	//------------------------------------------------------------------------------------------------
+	static void GetParameters(Managed profile, notnull array<string> outNames)
+	{
+		typename type = profile.Type();
+		for (int i = 0; i < type.GetVariableCount(); i++)
+		{
+			if (IsTunable(type.GetVariableType(i)))
+				outNames.Insert(GetParameterName(type.GetVariableName(i)));
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Current value as text, empty if the profile has no such parameter
+	//------------------------------------------------------------------------------------------------
+	static string Get(Managed profile, string parameter)
+	{
+		string variableName;
+		typename variableType;
+		if (!Find(profile, parameter, variableName, variableType))
+			return string.Empty;
+
+		if (variableType == float)
+		{
+			float floatValue;
+			EnScript.GetClassVar(profile, variableName, 0, floatValue);
+			return floatValue.ToString();
+		}
+
+		if (variableType == int)
+		{
+			int intValue;
+			EnScript.GetClassVar(profile, variableName, 0, intValue);
+			return intValue.ToString();
+		}
+
+		bool boolValue;
+		EnScript.GetClassVar(profile, variableName, 0, boolValue);
+		return boolValue.ToString();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Parse and write a value, false if the profile has no such parameter
+	//------------------------------------------------------------------------------------------------
+	static bool Set(Managed profile, string parameter, string value)
+	{
+		string variableName;
+		typename variableType;
+		if (!Find(profile, parameter, variableName, variableType))
+			return false;
+
+		if (variableType == float)
+		{
+			EnScript.SetClassVar(profile, variableName, 0, value.ToFloat());
+		}
+		else if (variableType == int)
+		{
+			EnScript.SetClassVar(profile, variableName, 0, value.ToInt());
+		}
+		else
+		{
+			string lower = value;
+			lower.ToLower();
+			EnScript.SetClassVar(profile, variableName, 0, lower == "true" || lower == "1");
+		}
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Copy every tunable parameter between two profiles of the same class
+	//------------------------------------------------------------------------------------------------
+	static void Copy(Managed source, Managed target)
+	{
+		array<string> parameters = {};
+		GetParameters(source, parameters);
+		foreach (string parameter : parameters)
+		{
+			Set(target, parameter, Get(source, parameter));
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Case-insensitive lookup of a parameter's member variable
+	//------------------------------------------------------------------------------------------------
+	protected static bool Find(Managed profile, string parameter, out string variableName, out typename variableType)
+	{
+		string wanted = parameter;
+		wanted.ToLower();
+
+		typename type = profile.Type();
+		for (int i = 0; i < type.GetVariableCount(); i++)
+		{
+			if (!IsTunable(type.GetVariableType(i)))
+				continue;
+
+			string name = GetParameterName(type.GetVariableName(i));
+			name.ToLower();
+			if (name != wanted)
+				continue;
+
+			variableName = type.GetVariableName(i);
+			variableType = type.GetVariableType(i);
+			return true;
+		}
+
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static bool IsTunable(typename variableType)
+	{
+		return variableType == float || variableType == int || variableType == bool;
+	}
+}
+
+#ifndef VSC_SERVER_LITE
+//------------------------------------------------------------------------------------------------
+// #vsc chat command, executed on the issuing client where its hearing pipeline runs
+//------------------------------------------------------------------------------------------------
+class VSC_TuningCommand : ScrServerCommand
+{
+	//------------------------------------------------------------------------------------------------
+	override string GetKeyword()
+	{
+		return "vsc";
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override bool IsServerSide()
+	{
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override int RequiredRCONPermission()
+	{
+		return ERCONPermissions.PERMISSIONS_NONE;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override int RequiredChatPermission()
+	{
+		return EPlayerRole.NONE;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override ref ScrServerCmdResult OnChatClientExecution(array<string> argv, int playerId)
+	{
+#ifndef ENABLE_DIAG
+		// Tuning changes what the player hears - not for everyone on a live server
+		PlayerManager playerManager = GetGame().GetPlayerManager();
+		if (!playerManager.HasPlayerRole(playerId, EPlayerRole.ADMINISTRATOR) && !playerManager.HasPlayerRole(playerId, EPlayerRole.SESSION_ADMINISTRATOR))
+			return new ScrServerCmdResult("VSC tuning requires admin rights", EServerCmdResultType.ERR);
+#endif
+
+		VSC_LocalController controller = VSC_LocalController.GetInstance();
+		if (!controller)
+			return new ScrServerCmdResult("VSC is not running on this client", EServerCmdResultType.ERR);
+
+		string action = "list";
+		if (argv.Count() > 1)
+		{
+			action = argv[1];
+			action.ToLower();
+		}
+
+		switch (action)
+		{
+			case "list":
+				return new ScrServerCmdResult(FormatParameters(controller), EServerCmdResultType.OK);
+
+			case "get":
+			{
+				if (argv.Count() < 3)
+					return new ScrServerCmdResult("Usage: #vsc get <key>", EServerCmdResultType.PARAMETERS);
+
+				string value = controller.GetParameter(argv[2]);
+				if (value.IsEmpty())
+					return new ScrServerCmdResult("Unknown parameter " + argv[2], EServerCmdResultType.ERR);
+
+				return new ScrServerCmdResult(argv[2] + " = " + value, EServerCmdResultType.OK);
+			}
+
+			case "set":
+			{
+				if (argv.Count() < 4 || argv.Count() % 2 != 0)
+					return new ScrServerCmdResult("Usage: #vsc set <key> <value> [<key> <value> ...]", EServerCmdResultType.PARAMETERS);
+
+				// Validate everything first so a typo never applies half of the change
+				for (int i = 2; i < argv.Count(); i += 2)
+				{
+					if (controller.GetParameter(argv[i]).IsEmpty())
+						return new ScrServerCmdResult("Unknown parameter " + argv[i], EServerCmdResultType.ERR);
+				}
+
+				for (int j = 2; j < argv.Count(); j += 2)
+				{
+					controller.SetParameter(argv[j], argv[j + 1]);
+				}
+
+				return new ScrServerCmdResult("Applied on the next frame", EServerCmdResultType.OK);
+			}
+
+			case "reset":
+				controller.ResetTuning();
+				return new ScrServerCmdResult("Headgear profiles restored on the next frame", EServerCmdResultType.OK);
+
+			case "cost":
+				return new ScrServerCmdResult(FormatCost(controller.GetStageStats()), EServerCmdResultType.OK);
+		}
+
+		return new ScrServerCmdResult("Usage: #vsc [list | get <key> | set <key> <value> ... | reset | cost]", EServerCmdResultType.PARAMETERS);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override ref ScrServerCmdResult OnChatServerExecution(array<string> argv, int playerId)
+	{
+		return new ScrServerCmdResult(string.Empty, EServerCmdResultType.OK);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override ref ScrServerCmdResult OnRCONExecution(array<string> argv)
+	{
+		return new ScrServerCmdResult("VSC tuning is client side, use the in-game chat", EServerCmdResultType.ERR);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override ref ScrServerCmdResult OnUpdate()
+	{
+		return new ScrServerCmdResult(string.Empty, EServerCmdResultType.OK);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected string FormatParameters(VSC_LocalController controller)
+	{
+		array<string> keys = {};
+		controller.GetParameterKeys(keys);
+
+		string text;
+		foreach (string key : keys)
+		{
+			text += key + " = " + controller.GetParameter(key) + "\n";
+		}
+
+		return text;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static string FormatCost(VSC_StageStats stats)
+	{
+		string text;
+		for (int stage = 0; stage < EVSC_Stage.COUNT; stage++)
+		{
+			text += string.Format("%1: %2 us/tick over %3 ticks\n", VSC_StageStats.GetStageName(stage), stats.GetAverageMicroseconds(stage).ToString(-1, 1), stats.GetCalls(stage));
+		}
+
+		return text;
+	}
+}
+#endif
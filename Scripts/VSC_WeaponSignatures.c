@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - Weapon Acoustic Signatures
+// How loud a weapon's report is: calibre class, peak level, muzzle directivity and suppressor.
+// One shared entry per weapon prefab and suppressor state is built from prefab data the first
+// time that weapon fires. Each weapon remembers its entry until its attachments change or it is
+// deleted, so a shot costs one map lookup. The compressor's weapon trigger range is set for the
+// reference report (an unsuppressed intermediate rifle); other reports scale it by their level
+// difference.
+// Not compiled with VSC_NO_WEAPON_MONITOR.
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+#ifndef VSC_NO_WEAPON_MONITOR
+enum EVSC_Calibre
+{
+	PISTOL,
+	INTERMEDIATE, // Assault rifles and carbines, the reference report
+	FULL_POWER, // Battle rifles, machine guns, sniper rifles
+	HEAVY // Launchers and heavy weapons
+}
+
+//------------------------------------------------------------------------------------------------
+// Acoustic signature of one weapon prefab in one suppressor state (shared, do not modify)
+//------------------------------------------------------------------------------------------------
+class VSC_WeaponSignature
+{
+	EVSC_Calibre m_eCalibre;
+	bool m_bSuppressed;
+	float m_fPeakLoudness; // dB SPL at 1 m in front of the muzzle
+	float m_fDirectivity; // 0 = same level all around, 1 = DIRECTIVITY_RANGE_DB quieter behind the muzzle
+	float m_fRangeScale; // Trigger range relative to the reference report, from m_fPeakLoudness
+}
+
+//------------------------------------------------------------------------------------------------
+class VSC_WeaponSignatures
+{
+	static const float REFERENCE_LOUDNESS = 165.0; // Unsuppressed intermediate rifle
+	static const float SUPPRESSOR_REDUCTION = 20.0; // dB
+	static const float DIRECTIVITY_RANGE_DB = 12.0; // Front to back level difference at full directivity
+	static const float MAX_RANGE_SCALE = 3.2; // Loudest signature (unsuppressed heavy), sizes the fire check range
+
+	private static ref map<string, ref VSC_WeaponSignature> s_mByPrefab = new map<string, ref VSC_WeaponSignature>();
+	private static ref map<string, VSC_WeaponSignature> s_mByWeapon = new map<string, VSC_WeaponSignature>(); // Entity ID -> entry
+
+	//------------------------------------------------------------------------------------------------
+	// Signature of a weapon entity as currently fitted
+	//------------------------------------------------------------------------------------------------
+	static VSC_WeaponSignature Get(IEntity weaponEntity, BaseWeaponComponent weapon)
+	{
+		string weaponKey = weaponEntity.GetID().ToString();
+		VSC_WeaponSignature signature;
+		if (s_mByWeapon.Find(weaponKey, signature))
+			return signature;
+
+		ResourceName prefab;
+		EntityPrefabData prefabData = weaponEntity.GetPrefabData();
+		if (prefabData)
+			prefab = prefabData.GetPrefabName();
+
+		signature = GetSignature(prefab, GetCalibre(weapon), IsSuppressed(weaponEntity));
+		s_mByWeapon.Insert(weaponKey, signature);
+		return signature;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Shared entry for a prefab and suppressor state, built on first use
+	//------------------------------------------------------------------------------------------------
+	static VSC_WeaponSignature GetSignature(ResourceName prefab, EVSC_Calibre calibre, bool suppressed)
+	{
+		string key = prefab + "|" + suppressed.ToString();
+		VSC_WeaponSignature signature;
+		if (s_mByPrefab.Find(key, signature))
+			return signature;
+
+		signature = new VSC_WeaponSignature();
+		signature.m_eCalibre = calibre;
+		signature.m_bSuppressed = suppressed;
+
+		switch (calibre)
+		{
+			case EVSC_Calibre.PISTOL:
+				signature.m_fPeakLoudness = 157.0;
+				signature.m_fDirectivity = 0.3;
+				break;
+
+			case EVSC_Calibre.INTERMEDIATE:
+				signature.m_fPeakLoudness = 165.0;
+				signature.m_fDirectivity = 0.5;
+				break;
+
+			case EVSC_Calibre.FULL_POWER:
+				signature.m_fPeakLoudness = 170.0;
+				signature.m_fDirectivity = 0.5;
+				break;
+
+			case EVSC_Calibre.HEAVY:
+				signature.m_fPeakLoudness = 175.0;
+				signature.m_fDirectivity = 0.6;
+				break;
+		}
+
+		// A suppressor takes the edge off the blast and most of its forward bias
+		if (suppressed)
+		{
+			signature.m_fPeakLoudness = signature.m_fPeakLoudness - SUPPRESSOR_REDUCTION;
+			signature.m_fDirectivity = signature.m_fDirectivity * 0.5;
+		}
+
+		signature.m_fRangeScale = Math.Pow(10.0, (signature.m_fPeakLoudness - REFERENCE_LOUDNESS) / 20.0);
+		s_mByPrefab.Insert(key, signature);
+		return signature;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// A muzzle attachment was added or removed - resolve the weapon again on its next shot
+	//------------------------------------------------------------------------------------------------
+	static void OnAttachmentsChanged(IEntity weaponEntity)
+	{
+		if (weaponEntity)
+			s_mByWeapon.Remove(weaponEntity.GetID().ToString());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// A weapon was deleted - drop its entry (its prefab entry stays)
+	//------------------------------------------------------------------------------------------------
+	static void Forget(IEntity weaponEntity)
+	{
+		if (weaponEntity)
+			s_mByWeapon.Remove(weaponEntity.GetID().ToString());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static EVSC_Calibre GetCalibre(BaseWeaponComponent weapon)
+	{
+		if (!weapon)
+			return EVSC_Calibre.INTERMEDIATE;
+
+		EWeaponType type = weapon.GetWeaponType();
+		if (type == EWeaponType.WT_HANDGUN)
+			return EVSC_Calibre.PISTOL;
+
+		if (type == EWeaponType.WT_MACHINEGUN || type == EWeaponType.WT_SNIPERRIFLE)
+			return EVSC_Calibre.FULL_POWER;
+
+		if (type == EWeaponType.WT_ROCKETLAUNCHER)
+			return EVSC_Calibre.HEAVY;
+
+		return EVSC_Calibre.INTERMEDIATE;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Whether a suppressor (or silencer) prefab sits in one of the weapon's attachment slots
+	//------------------------------------------------------------------------------------------------
+	protected static bool IsSuppressed(IEntity weaponEntity)
+	{
+		array<Managed> slots = {};
+		weaponEntity.FindComponents(AttachmentSlotComponent, slots);
+		foreach (Managed slot : slots)
+		{
+			IEntity attachment = AttachmentSlotComponent.Cast(slot).GetAttachedEntity();
+			if (!attachment || !attachment.GetPrefabData())
+				continue;
+
+			string prefab = attachment.GetPrefabData().GetPrefabName();
+			prefab.ToLower();
+			if (prefab.Contains("suppressor") || prefab.Contains("silencer"))
+				return true;
+		}
+
+		return false;
+	}
+}
+
+modded class SCR_WeaponAttachmentsStorageComponent
+{
+	//------------------------------------------------------------------------------------------------
+	override protected void OnAddedToSlot(IEntity item, int slotID)
+	{
+		super.OnAddedToSlot(item, slotID);
+
+		VSC_WeaponSignatures.OnAttachmentsChanged(GetOwner());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override protected void OnRemovedFromSlot(IEntity item, int slotID)
+	{
+		super.OnRemovedFromSlot(item, slotID);
+
+		VSC_WeaponSignatures.OnAttachmentsChanged(GetOwner());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void OnDelete(IEntity owner)
+	{
+		VSC_WeaponSignatures.Forget(owner);
+
+		super.OnDelete(owner);
+	}
+}
+#endif
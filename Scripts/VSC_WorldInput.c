@@ -0,0 +1,513 @@
+//------------------------------------------------------------------------------------------------
+// Virtual Sound Compressor - World Input
+// Live VSC_InputProvider reading the game world around the local character. Client only, not
+// compiled with VSC_SERVER_LITE; weapon fire detection is left out with VSC_NO_WEAPON_MONITOR.
+// A character's or vehicle's sound components are looked up once, on first contact, through a
+// budgeted queue (see VSC_ClassificationQueue); later classification reads the cached components.
+// Author: jcrashkit
+//------------------------------------------------------------------------------------------------
+
+#ifndef VSC_SERVER_LITE
+//------------------------------------------------------------------------------------------------
+// Components an entity is heard through, resolved once per entity
+//------------------------------------------------------------------------------------------------
+class VSC_EntityAudio
+{
+	ChimeraCharacter m_Character;
+	SCR_VoNComponent m_VoN;
+	WeaponManagerComponent m_WeaponManager;
+	VehicleControllerComponent m_VehicleController;
+	float m_fLastSeen;
+
+#ifndef VSC_NO_WEAPON_MONITOR
+	// Fire detection: the current weapon's magazine and its rounds when last checked
+	BaseMagazineComponent m_Magazine;
+	int m_iAmmoCount;
+	float m_fLastFireCheck;
+#endif
+}
+
+//------------------------------------------------------------------------------------------------
+class VSC_WorldInput : VSC_InputProvider
+{
+	// Activity gate thresholds
+	private const float FOOTSTEP_MIN_SPEED = 0.5; // m/s, slower movement is effectively silent
+	private const float PRONE_FOOTSTEP_MIN_SPEED = 1.0; // Crawling is quieter, only a fast crawl is heard
+
+	private ChimeraCharacter m_Listener;
+	private BaseWorld m_World; // Cached on bind, per-source lookups skip GetGame()
+	private VSC_Clock m_Clock; // Shared world clock, sampled on BeginFrame and GetTime
+
+	// Acoustic environment: baked grid cells, or a fixed cabin while seated in a vehicle
+	private ref VSC_WorldAcousticGrid m_AcousticGrid = new VSC_WorldAcousticGrid();
+	private ref VSC_Acoustics m_VehicleAcoustics = new VSC_Acoustics();
+	private VSC_Acoustics m_Acoustics;
+
+	// First contact: component lookups for at most CLASSIFY_BUDGET entities per tick
+	private const int CLASSIFY_BUDGET = 32;
+	private const int RESOLVED_CLEANUP_TICKS = 100; // 5 s
+	private const float RESOLVED_EXPIRY_MS = 10000.0; // Entities not seen this long are resolved again on return
+	private ref VSC_ClassificationQueue m_ClassificationQueue = new VSC_ClassificationQueue();
+	private ref map<string, ref VSC_EntityAudio> m_mResolved = new map<string, ref VSC_EntityAudio>();
+	private ref array<ref VSC_SourceSample> m_aResolveBatch = {};
+	private int m_iResolvedCleanupCounter = 0;
+
+#ifndef VSC_NO_WEAPON_MONITOR
+	private const int CLEANUP_INTERVAL_FRAMES = 20; // 20 x 50ms controller ticks = 1s
+	private const float RECENT_FIRE_MS = 1000.0; // A weapon stays audible this long after its last shot
+	private const float FIRE_TRACKING_MS = 2000.0; // Fire entries are dropped this long after the last shot
+	private const float FIRE_CHECK_STALE_MS = 250.0; // Rounds lost over a longer gap between checks are not reported as a shot
+	private const int MAX_FIRE_CHECKS = 16; // Nearest characters checked for fire per frame
+	private int m_iCleanupCounter = 0;
+	private ref map<string, float> m_mRecentWeaponFire = new map<string, float>(); // Track recent weapon fire events
+	private ref array<VSC_EntityAudio> m_aFireCandidates = {}; // Resolved characters, nearest first
+	private ref array<float> m_aFireCandidateDistances = {}; // Squared, matching m_aFireCandidates
+#endif
+
+	//------------------------------------------------------------------------------------------------
+	void VSC_WorldInput()
+	{
+		m_Clock = VSC_Clock.GetWorldClock();
+		m_VehicleAcoustics.Set(1.0, 0.0, 1.0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void SetListener(ChimeraCharacter listener)
+	{
+		m_Listener = listener;
+		m_World = GetGame().GetWorld();
+#ifndef VSC_NO_WEAPON_MONITOR
+		m_mRecentWeaponFire.Clear();
+#endif
+		m_Acoustics = null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Called once per controller tick before the processors run
+	//------------------------------------------------------------------------------------------------
+	void BeginFrame()
+	{
+		if (m_World)
+			m_Clock.Sample(m_World.GetWorldTime());
+
+		// One lookup per tick, shared by all stages
+		if (m_Listener.IsInVehicle())
+			m_Acoustics = m_VehicleAcoustics;
+		else
+			m_Acoustics = m_AcousticGrid.Lookup(m_Listener.GetOrigin());
+
+		ResolvePending();
+
+		m_iResolvedCleanupCounter++;
+		if (m_iResolvedCleanupCounter >= RESOLVED_CLEANUP_TICKS)
+		{
+			m_iResolvedCleanupCounter = 0;
+			CleanupResolved();
+		}
+
+#ifndef VSC_NO_WEAPON_MONITOR
+		// Clean up old weapon fire tracking entries periodically
+		m_iCleanupCounter++;
+		if (m_iCleanupCounter >= CLEANUP_INTERVAL_FRAMES)
+		{
+			m_iCleanupCounter = 0;
+			CleanupWeaponFireTracking();
+		}
+#endif
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override float GetTime()
+	{
+		if (m_World)
+			m_Clock.Sample(m_World.GetWorldTime());
+
+		return m_Clock.GetMs();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override vector GetListenerOrigin()
+	{
+		return m_Listener.GetOrigin();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override vector GetListenerForward()
+	{
+		Transform listenerTransform = m_Listener.GetTransform();
+		return listenerTransform[2]; // Forward vector from transform matrix
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override VSC_Acoustics GetListenerAcoustics()
+	{
+		if (!m_Acoustics)
+			return s_OpenTerrain;
+
+		return m_Acoustics;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Currently audible sources within radius of the listener, in one query (trace capture)
+	//------------------------------------------------------------------------------------------------
+	void QuerySources(float radius, notnull array<ref VSC_SourceSample> outSamples)
+	{
+		CollectSources(m_Listener.GetOrigin(), radius, null, outSamples);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override void QueryRegion(VSC_SweepRegion region, notnull array<ref VSC_SourceSample> outSamples)
+	{
+		CollectSources(region.GetCenter(), region.m_fQueryRadius, region, outSamples);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Classify the entities within radius of center, only those in region if one is given
+	//------------------------------------------------------------------------------------------------
+	protected void CollectSources(vector center, float radius, VSC_SweepRegion region, notnull array<ref VSC_SourceSample> outSamples)
+	{
+		if (!m_World)
+			return;
+
+		array<Managed> found = {};
+		array<Class> excludeClasses = {};
+		array<Object> objects = {};
+		m_World.FindEntitiesAround(center, radius, excludeClasses, found, objects);
+
+		float currentTime = m_Clock.GetMs();
+		foreach (Managed obj : found)
+		{
+			IEntity entity = IEntity.Cast(obj);
+			if (!entity || entity == m_Listener)
+				continue;
+
+			// Overlapping query spheres: each entity is classified by its own region only
+			if (region && !region.Contains(entity.GetOrigin()))
+				continue;
+
+			string id = entity.GetID().ToString();
+			int classFlags = ClassifyEntity(entity, id, currentTime);
+			if (classFlags == 0)
+				continue;
+
+			VSC_SourceSample sample = new VSC_SourceSample();
+			sample.m_sId = id;
+			sample.m_EntityId = entity.GetID();
+			sample.m_vPosition = entity.GetOrigin();
+			sample.m_iClassFlags = classFlags;
+			outSamples.Insert(sample);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override bool GetSourceState(VSC_TrackedSoundSource source, out vector position, out int classFlags)
+	{
+		// Resolved by ID every time - a deleted entity is simply not found
+		IEntity entity = m_World.FindEntityByID(source.m_EntityId);
+		if (!entity)
+			return false;
+
+		// Sources that went quiet leave the tracker at their next refresh
+		classFlags = ClassifyEntity(entity, source.m_sId, m_Clock.GetMs());
+		if (classFlags == 0)
+			return false;
+
+		position = entity.GetOrigin();
+		return true;
+	}
+
+#ifndef VSC_NO_WEAPON_MONITOR
+	//------------------------------------------------------------------------------------------------
+	// Detects the nearest characters firing weapons from their magazines losing rounds
+	//------------------------------------------------------------------------------------------------
+	override void CollectWeaponFire(float range, notnull array<ref VSC_WeaponFire> outFire)
+	{
+		if (!m_World)
+			return;
+
+		vector playerPos = m_Listener.GetOrigin();
+		float currentTime = m_Clock.GetMs();
+		float rangeSq = range * range;
+
+		// Candidates are the characters the tracker already resolved (the discovery sweep finds
+		// new ones), so no world query runs here. Only the MAX_FIRE_CHECKS nearest are checked.
+		foreach (VSC_EntityAudio resolved : m_mResolved)
+		{
+			ChimeraCharacter character = resolved.m_Character;
+			if (!character || character == m_Listener || !resolved.m_WeaponManager)
+				continue;
+
+			float distanceSq = vector.DistanceSq(playerPos, character.GetOrigin());
+			if (distanceSq <= rangeSq)
+				InsertFireCandidate(resolved, distanceSq);
+		}
+
+		foreach (VSC_EntityAudio audio : m_aFireCandidates)
+		{
+			// Get the currently equipped weapon
+			BaseWeaponComponent weapon = audio.m_WeaponManager.GetCurrentWeapon();
+			if (!weapon)
+				continue;
+
+			IEntity weaponEntity = weapon.GetOwner();
+			if (!weaponEntity || !HasFiredSinceLastCheck(audio, weapon, currentTime))
+				continue;
+
+			m_mRecentWeaponFire.Set(weaponEntity.GetID().ToString(), currentTime);
+			outFire.Insert(CreateWeaponFire(weaponEntity, weapon));
+		}
+
+		m_aFireCandidates.Clear();
+		m_aFireCandidateDistances.Clear();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Keep the MAX_FIRE_CHECKS nearest characters, in order of distance
+	//------------------------------------------------------------------------------------------------
+	protected void InsertFireCandidate(VSC_EntityAudio audio, float distanceSq)
+	{
+		int index = m_aFireCandidateDistances.Count();
+		if (index >= MAX_FIRE_CHECKS && distanceSq >= m_aFireCandidateDistances[index - 1])
+			return;
+
+		while (index > 0 && m_aFireCandidateDistances[index - 1] > distanceSq)
+		{
+			index--;
+		}
+
+		m_aFireCandidates.InsertAt(audio, index);
+		m_aFireCandidateDistances.InsertAt(distanceSq, index);
+
+		// Drop the farthest (removing the last element keeps the order)
+		if (m_aFireCandidates.Count() > MAX_FIRE_CHECKS)
+		{
+			m_aFireCandidates.Remove(MAX_FIRE_CHECKS);
+			m_aFireCandidateDistances.Remove(MAX_FIRE_CHECKS);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Whether the weapon's magazine lost rounds since the previous check. A reload, a weapon
+	// switch or a gap of more than FIRE_CHECK_STALE_MS between checks only re-reads the count.
+	//------------------------------------------------------------------------------------------------
+	protected bool HasFiredSinceLastCheck(VSC_EntityAudio audio, BaseWeaponComponent weapon, float currentTime)
+	{
+		BaseMagazineComponent magazine = weapon.GetCurrentMagazine();
+		int ammoCount = 0;
+		if (magazine)
+			ammoCount = magazine.GetAmmoCount();
+
+		bool fired = magazine && magazine == audio.m_Magazine && ammoCount < audio.m_iAmmoCount;
+		if (currentTime - audio.m_fLastFireCheck > FIRE_CHECK_STALE_MS)
+			fired = false;
+
+		audio.m_Magazine = magazine;
+		audio.m_iAmmoCount = ammoCount;
+		audio.m_fLastFireCheck = currentTime;
+		return fired;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// A shot from a weapon with its report's signature (one table lookup)
+	//------------------------------------------------------------------------------------------------
+	protected VSC_WeaponFire CreateWeaponFire(IEntity weaponEntity, BaseWeaponComponent weapon)
+	{
+		VSC_WeaponSignature signature = VSC_WeaponSignatures.Get(weaponEntity, weapon);
+
+		VSC_WeaponFire fire = new VSC_WeaponFire();
+		fire.m_vPosition = weaponEntity.GetOrigin();
+		fire.m_vDirection = weaponEntity.GetTransformAxis(2);
+		fire.m_fRangeScale = signature.m_fRangeScale;
+		fire.m_fDirectivity = signature.m_fDirectivity;
+		return fire;
+	}
+#endif
+
+	//------------------------------------------------------------------------------------------------
+	// Classify what an entity is audibly doing right now (0 = silent, not a sound source)
+	// Reads cheap component state only, so idle characters, corpses, dropped weapons and
+	// parked vehicles never reach the tracker. Only characters and vehicles have sound components
+	// to look up: one seen for the first time is queued for them, and until then a character is
+	// heard by its footsteps alone. Buildings, props and trees are rejected by type and never
+	// queued or cached; a weapon is known from fire detection alone.
+	//------------------------------------------------------------------------------------------------
+	protected int ClassifyEntity(IEntity entity, string id, float currentTime)
+	{
+		VSC_EntityAudio audio = m_mResolved.Get(id);
+		if (!audio)
+		{
+			ChimeraCharacter character = ChimeraCharacter.Cast(entity);
+			if (character)
+			{
+				m_ClassificationQueue.Enqueue(id, entity.GetID());
+				return Math.Max(ClassifyMovement(character), 0);
+			}
+
+			if (Vehicle.Cast(entity))
+			{
+				m_ClassificationQueue.Enqueue(id, entity.GetID());
+				return 0;
+			}
+
+#ifndef VSC_NO_WEAPON_MONITOR
+			// Weapons are only heard when they fire
+			if (HasFiredRecently(id, currentTime))
+				return EVSC_SourceClass.WEAPON;
+#endif
+
+			return 0;
+		}
+
+		audio.m_fLastSeen = currentTime;
+		if (audio.m_Character)
+			return ClassifyCharacter(audio, currentTime);
+
+		if (audio.m_VehicleController && audio.m_VehicleController.IsEngineOn())
+			return EVSC_SourceClass.VEHICLE;
+
+		return 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Footsteps from movement speed and stance, voice from VoN, combat from recent firing
+	//------------------------------------------------------------------------------------------------
+	protected int ClassifyCharacter(VSC_EntityAudio audio, float currentTime)
+	{
+		int classFlags = ClassifyMovement(audio.m_Character);
+		if (classFlags < 0)
+			return 0;
+
+		if (audio.m_VoN && audio.m_VoN.IsTransmitting())
+			classFlags |= EVSC_SourceClass.VOICE;
+
+#ifndef VSC_NO_WEAPON_MONITOR
+		if (audio.m_WeaponManager)
+		{
+			BaseWeaponComponent weapon = audio.m_WeaponManager.GetCurrentWeapon();
+			if (weapon && weapon.GetOwner() && HasFiredRecently(weapon.GetOwner().GetID().ToString(), currentTime))
+				classFlags |= EVSC_SourceClass.WEAPON;
+		}
+#endif
+
+		if (classFlags != 0)
+			classFlags |= EVSC_SourceClass.CHARACTER;
+
+		return classFlags;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Footsteps only, through the character controller (no component search), -1 if not alive
+	//------------------------------------------------------------------------------------------------
+	protected int ClassifyMovement(ChimeraCharacter character)
+	{
+		CharacterControllerComponent controller = character.GetCharacterController();
+		if (!controller || controller.GetLifeState() != ECharacterLifeState.ALIVE)
+			return -1;
+
+		float minSpeed = FOOTSTEP_MIN_SPEED;
+		if (controller.GetStance() == ECharacterStance.PRONE)
+			minSpeed = PRONE_FOOTSTEP_MIN_SPEED;
+
+		if (controller.GetMovementVelocity().LengthSq() >= minSpeed * minSpeed)
+			return EVSC_SourceClass.CHARACTER | EVSC_SourceClass.MOVEMENT;
+
+		return 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Component lookups for the longest waiting first contacts, at most CLASSIFY_BUDGET per tick
+	//------------------------------------------------------------------------------------------------
+	protected void ResolvePending()
+	{
+		if (!m_World || m_ClassificationQueue.Count() == 0)
+			return;
+
+		float currentTime = m_Clock.GetMs();
+		m_ClassificationQueue.Take(CLASSIFY_BUDGET, m_aResolveBatch);
+		foreach (VSC_SourceSample pending : m_aResolveBatch)
+		{
+			// Deleted while it waited
+			IEntity entity = m_World.FindEntityByID(pending.m_EntityId);
+			if (!entity)
+				continue;
+
+			VSC_EntityAudio audio = new VSC_EntityAudio();
+			audio.m_fLastSeen = currentTime;
+			audio.m_Character = ChimeraCharacter.Cast(entity);
+			if (audio.m_Character)
+			{
+				audio.m_VoN = SCR_VoNComponent.Cast(entity.FindComponent(SCR_VoNComponent));
+#ifndef VSC_NO_WEAPON_MONITOR
+				audio.m_WeaponManager = WeaponManagerComponent.Cast(entity.FindComponent(WeaponManagerComponent));
+#endif
+			}
+			else
+			{
+				audio.m_VehicleController = VehicleControllerComponent.Cast(entity.FindComponent(VehicleControllerComponent));
+			}
+
+			m_mResolved.Set(pending.m_sId, audio);
+		}
+
+		m_aResolveBatch.Clear();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Forget entities that have been out of every query for a while (left behind or deleted)
+	//------------------------------------------------------------------------------------------------
+	protected void CleanupResolved()
+	{
+		float currentTime = m_Clock.GetMs();
+		array<string> expired = {};
+		foreach (string id, VSC_EntityAudio audio : m_mResolved)
+		{
+			if (currentTime - audio.m_fLastSeen > RESOLVED_EXPIRY_MS)
+				expired.Insert(id);
+		}
+
+		foreach (string expiredId : expired)
+		{
+			m_mResolved.Remove(expiredId);
+		}
+	}
+
+#ifndef VSC_NO_WEAPON_MONITOR
+	//------------------------------------------------------------------------------------------------
+	// Whether weapon fire detection saw this weapon fire within RECENT_FIRE_MS
+	//------------------------------------------------------------------------------------------------
+	protected bool HasFiredRecently(string weaponKey, float currentTime)
+	{
+		float fireTime;
+		if (!m_mRecentWeaponFire.Find(weaponKey, fireTime))
+			return false;
+
+		return currentTime - fireTime < RECENT_FIRE_MS;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	// Clean up old weapon fire tracking entries
+	//------------------------------------------------------------------------------------------------
+	protected void CleanupWeaponFireTracking()
+	{
+		float currentTime = m_Clock.GetMs();
+		array<string> keysToRemove = {};
+
+		// Remove entries older than FIRE_TRACKING_MS
+		for (int i = 0; i < m_mRecentWeaponFire.Count(); i++)
+		{
+			string key = m_mRecentWeaponFire.GetKey(i);
+			float fireTime = m_mRecentWeaponFire.Get(key);
+			if (currentTime - fireTime > FIRE_TRACKING_MS)
+			{
+				keysToRemove.Insert(key);
+			}
+		}
+
+		foreach (string key : keysToRemove)
+		{
+			m_mRecentWeaponFire.Remove(key);
+		}
+	}
+#endif
+}
+#endif